@@ -14,6 +14,11 @@
 #	                      build, but which is not part of the library nor is
 #	                      run as tests.
 #
+#	BENCHMARK_SOURCE_FILES
+#	                      Microbenchmark programs; one executable per file.
+#	                      They are not part of the default build - use the
+#	                      'benchmarks' target to compile them.
+#
 #	PUBLIC_HEADER_FILES   List of public header files that should be
 #	                      distributed together with the library. The source
 #	                      files can of course include other files than these;
@@ -22,6 +27,9 @@
 
 list (APPEND MAIN_SOURCE_FILES
       opm/common/data/SimulationDataContainer.cpp
+      opm/common/data/TimeSeriesRecorder.cpp
+      opm/common/OpmLog/AggregatingLog.cpp
+      opm/common/OpmLog/BinaryLog.cpp
       opm/common/OpmLog/CounterLog.cpp
       opm/common/OpmLog/EclipsePRTLog.cpp
       opm/common/OpmLog/LogBackend.cpp
@@ -35,8 +43,10 @@ list (APPEND MAIN_SOURCE_FILES
 list (APPEND TEST_SOURCE_FILES
       tests/test_SimulationDataContainer.cpp
       tests/test_cmp.cpp
+      tests/test_diff.cpp
       tests/test_OpmLog.cpp
       tests/test_messagelimiter.cpp
+      tests/test_TimeSeriesRecorder.cpp
       )
 
 list (APPEND TEST_DATA_FILES
@@ -45,6 +55,13 @@ list (APPEND TEST_DATA_FILES
 list (APPEND EXAMPLE_SOURCE_FILES
 	)
 
+list (APPEND BENCHMARK_SOURCE_FILES
+      benchmarks/bench_SimulationDataContainer.cpp
+      benchmarks/bench_cmp.cpp
+      benchmarks/bench_logger.cpp
+      benchmarks/bench_messagelimiter.cpp
+      )
+
 # programs listed here will not only be compiled, but also marked for
 # installation
 list (APPEND PROGRAM_SOURCE_FILES
@@ -58,6 +75,9 @@ list( APPEND PUBLIC_HEADER_FILES
       opm/common/Unused.hpp
       opm/common/Valgrind.hpp
       opm/common/data/SimulationDataContainer.hpp
+      opm/common/data/TimeSeriesRecorder.hpp
+      opm/common/OpmLog/AggregatingLog.hpp
+      opm/common/OpmLog/BinaryLog.hpp
       opm/common/OpmLog/CounterLog.hpp
       opm/common/OpmLog/EclipsePRTLog.hpp
       opm/common/OpmLog/LogBackend.hpp
@@ -69,5 +89,6 @@ list( APPEND PUBLIC_HEADER_FILES
       opm/common/OpmLog/StreamLog.hpp
       opm/common/OpmLog/TimerLog.hpp
       opm/common/util/numeric/cmp.hpp
+      opm/common/util/numeric/diff.hpp
       opm/common/utility/platform_dependent/disable_warnings.h
       opm/common/utility/platform_dependent/reenable_warnings.h)
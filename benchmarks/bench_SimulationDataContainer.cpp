@@ -0,0 +1,80 @@
+/*
+  Copyright 2016 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <opm/common/data/SimulationDataContainer.hpp>
+
+#include "benchmark.hpp"
+
+/*
+  Microbenchmarks for the SimulationDataContainer hot paths:
+  registration, name and handle based lookup, and the copy-on-write
+  copy constructor with and without the subsequent detach.
+*/
+
+using namespace Opm;
+
+int main() {
+    const size_t num_cells = 100000;
+    const size_t num_faces = 300000;
+    const size_t num_phases = 3;
+
+    benchmark::run("sdc_register_10_fields", [&]() {
+            SimulationDataContainer state( num_cells , num_faces , num_phases );
+            for (int i = 0; i < 10; i++)
+                state.registerCellData( "FIELD" + std::to_string( i ) , 1 );
+            benchmark::escape( &state );
+        });
+
+    {
+        SimulationDataContainer state( num_cells , num_faces , num_phases );
+        auto handle = state.registerCellData( "EXTRA" , 1 );
+
+        benchmark::run("sdc_lookup_by_name", [&]() {
+                const auto& data = state.getCellData( "EXTRA" );
+                benchmark::escape( data.data() );
+            });
+
+        benchmark::run("sdc_lookup_by_handle", [&]() {
+                const auto& data = state.getCellData( handle );
+                benchmark::escape( data.data() );
+            });
+    }
+
+    {
+        SimulationDataContainer state( num_cells , num_faces , num_phases );
+        auto handle = state.registerCellData( "EXTRA" , 1 );
+
+        /* The copy constructor itself: only reference count updates. */
+        benchmark::run("sdc_copy_shared", [&]() {
+                SimulationDataContainer copy( state );
+                benchmark::escape( &copy );
+            });
+
+        /* Copy followed by one mutable access, forcing a private
+           copy of that field - the trial timestep pattern. */
+        benchmark::run("sdc_copy_detach_one_field", [&]() {
+                SimulationDataContainer copy( state );
+                auto& data = copy.getCellData( handle );
+                data[0] = 1.0;
+                benchmark::escape( data.data() );
+            });
+    }
+
+    return 0;
+}
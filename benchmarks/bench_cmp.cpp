@@ -0,0 +1,66 @@
+/*
+  Copyright 2016 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <vector>
+
+#include <opm/common/util/numeric/cmp.hpp>
+
+#include "benchmark.hpp"
+
+/*
+  Microbenchmarks for the cmp::array_equal() kernels on 100k element
+  double arrays - the all-equal case which must scan the full array,
+  for both the epsilon based and the ULP based comparison, and the
+  bitwise identical case where the memcmp() fast path applies.
+*/
+
+using namespace Opm;
+
+int main() {
+    const size_t num_elements = 100000;
+
+    std::vector<double> v1( num_elements );
+    for (size_t i = 0; i < num_elements; i++)
+        v1[i] = 1.0 + 1e-12 * i;
+
+    /* Bitwise identical copy - the memcmp() fast path. */
+    std::vector<double> v2 = v1;
+
+    /* Equal within tolerance, but not bitwise identical. */
+    std::vector<double> v3 = v1;
+    for (size_t i = 0; i < num_elements; i++)
+        v3[i] += 1e-14;
+
+    benchmark::run("cmp_array_equal_bitwise", [&]() {
+            bool equal = cmp::array_equal<double>( v1.data() , v2.data() , num_elements );
+            benchmark::escape( &equal );
+        });
+
+    benchmark::run("cmp_array_equal_epsilon", [&]() {
+            bool equal = cmp::array_equal<double>( v1.data() , v3.data() , num_elements );
+            benchmark::escape( &equal );
+        });
+
+    benchmark::run("cmp_array_equal_ulp", [&]() {
+            bool equal = cmp::array_equal_ulp<double>( v1.data() , v3.data() , num_elements , 1000 );
+            benchmark::escape( &equal );
+        });
+
+    return 0;
+}
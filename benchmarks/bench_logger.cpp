@@ -0,0 +1,79 @@
+/*
+  Copyright 2016 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <memory>
+#include <string>
+
+#include <opm/common/OpmLog/CounterLog.hpp>
+#include <opm/common/OpmLog/Logger.hpp>
+#include <opm/common/OpmLog/LogUtil.hpp>
+
+#include "benchmark.hpp"
+
+/*
+  Microbenchmarks for the Logger dispatch path: the cost of one
+  addMessage() call as a function of the number of attached backends,
+  the cost of a message nobody listens to, and the lazy builder
+  overload when the category is masked off. CounterLog backends are
+  used as sinks - they only bump an atomic counter, so what is
+  measured is the dispatch itself.
+*/
+
+using namespace Opm;
+
+namespace {
+
+    void benchDispatch(const std::string& name, size_t num_backends) {
+        Logger logger;
+        for (size_t i = 0; i < num_backends; i++)
+            logger.addBackend( "COUNTER" + std::to_string( i ) , std::make_shared<CounterLog>( Log::DefaultMessageTypes ));
+
+        const std::string message = "The CFL condition was violated in cell 4567";
+        benchmark::run(name, [&]() {
+                logger.addMessage( Log::MessageType::Warning , message );
+            });
+    }
+
+}
+
+int main() {
+    benchDispatch( "logger_dispatch_1_backend" , 1 );
+    benchDispatch( "logger_dispatch_4_backends" , 4 );
+    benchDispatch( "logger_dispatch_16_backends" , 16 );
+
+    {
+        /* Backend listening to errors only: a warning is filtered by
+           the global mask without touching any backend. */
+        Logger logger;
+        logger.addBackend( "ERRORS" , std::make_shared<CounterLog>( Log::MessageType::Error ));
+        const std::string message = "The CFL condition was violated in cell 4567";
+
+        benchmark::run("logger_dispatch_masked_eager", [&]() {
+                logger.addMessage( Log::MessageType::Warning , message );
+            });
+
+        benchmark::run("logger_dispatch_masked_lazy", [&]() {
+                logger.addMessage( Log::MessageType::Warning , []() {
+                        return "The CFL condition was violated in cell " + std::to_string( 4567 );
+                    });
+            });
+    }
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+/*
+  Copyright 2016 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string>
+
+#include <opm/common/OpmLog/LogUtil.hpp>
+#include <opm/common/OpmLog/MessageLimiter.hpp>
+
+#include "benchmark.hpp"
+
+/*
+  Microbenchmarks for MessageLimiter::handleMessageLimits(): the
+  untagged category-count path, the string tag path (which hashes the
+  tag on every call), and the pre-registered tag id fast path.
+*/
+
+using namespace Opm;
+
+int main() {
+    {
+        MessageLimiter limiter;
+        benchmark::run("limiter_untagged_nolimit", [&]() {
+                auto response = limiter.handleMessageLimits( "" , Log::MessageType::Warning );
+                benchmark::escape( &response );
+            });
+    }
+
+    {
+        /* With a category limit the counter is bumped on every call;
+           the limit is high enough that the response stays
+           PrintMessage for the whole run. */
+        MessageLimiter limiter(MessageLimiter::NoLimit, {{ Log::MessageType::Warning , 1 << 30 }});
+        benchmark::run("limiter_untagged_category_limit", [&]() {
+                auto response = limiter.handleMessageLimits( "" , Log::MessageType::Warning );
+                benchmark::escape( &response );
+            });
+    }
+
+    {
+        MessageLimiter limiter( 1 << 30 );
+        const std::string tag = "CFL_VIOLATION_CELL_4567";
+
+        benchmark::run("limiter_tag_string", [&]() {
+                auto response = limiter.handleMessageLimits( tag , Log::MessageType::Warning );
+                benchmark::escape( &response );
+            });
+
+        const int tag_id = limiter.registerTag( tag );
+        benchmark::run("limiter_tag_id", [&]() {
+                auto response = limiter.handleMessageLimits( tag_id , Log::MessageType::Warning );
+                benchmark::escape( &response );
+            });
+    }
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*
+  Copyright 2016 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_BENCHMARK_HARNESS_HPP
+#define OPM_BENCHMARK_HARNESS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+/*
+  A deliberately small benchmark harness for the in-tree
+  microbenchmarks: no dependencies, steady_clock timing, and
+  machine-readable output so the numbers can be tracked across
+  releases. Each benchmark is a callable timed as
+
+      benchmark::run("name", [&]() { ...one operation... });
+
+  run() first calibrates the iteration count so one measurement
+  lasts long enough to be meaningful against the clock resolution,
+  then takes several measurements and reports the fastest - the
+  lower bound is the sample least disturbed by the rest of the
+  machine. One CSV line per benchmark goes to stdout:
+
+      name,iterations,ns_per_op
+*/
+
+namespace Opm {
+namespace benchmark {
+
+#if defined(__GNUC__) || defined(__clang__)
+    /* Keep the result of a computation alive without writing it
+       anywhere, so the optimizer can not remove the benchmarked
+       work. */
+    inline void escape(const void* pointer) {
+        asm volatile("" : : "g"(pointer) : "memory");
+    }
+#else
+    inline void escape(const void*) {}
+#endif
+
+    template <typename F>
+    void run(const std::string& name, F&& fn) {
+        typedef std::chrono::steady_clock clock;
+        const double min_measure_time = 0.10;
+        const int num_samples = 5;
+
+        /* Calibrate: grow the iteration count until one measurement
+           takes at least min_measure_time seconds. */
+        size_t iterations = 1;
+        while (true) {
+            const auto start = clock::now();
+            for (size_t i = 0; i < iterations; i++)
+                fn();
+            const double elapsed = std::chrono::duration<double>( clock::now() - start ).count();
+            if (elapsed >= min_measure_time)
+                break;
+            if (elapsed < min_measure_time / 100)
+                iterations *= 10;
+            else
+                iterations = size_t( iterations * (1.5 * min_measure_time / elapsed) ) + 1;
+        }
+
+        double best = -1;
+        for (int sample = 0; sample < num_samples; sample++) {
+            const auto start = clock::now();
+            for (size_t i = 0; i < iterations; i++)
+                fn();
+            const double elapsed = std::chrono::duration<double>( clock::now() - start ).count();
+            if (best < 0 || elapsed < best)
+                best = elapsed;
+        }
+
+        std::printf("%s,%zu,%.2f\n", name.c_str(), iterations, best * 1e9 / iterations);
+    }
+
+}
+}
+
+#endif
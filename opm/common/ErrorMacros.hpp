@@ -41,6 +41,38 @@
 # define OPM_MESSAGE_IF(cond, m) do {} while (false)
 #endif
 
+// The formatting body of the throw macros lives in this noinline
+// helper so that the macro expansion at the call site is only the
+// construction of a small lambda and one call: the ostringstream
+// setup and string building stay out of line and out of the icache
+// of the non-throwing fast path, which matters when OPM_THROW guards
+// hot per-cell lookup functions. The stream inserters in the message
+// run only if the throw is actually reached.
+#if defined(__GNUC__) || defined(__clang__)
+#define OPM_THROW_NOINLINE __attribute__((noinline))
+#else
+#define OPM_THROW_NOINLINE
+#endif
+
+namespace Opm {
+namespace detail {
+
+    template <class Exception, bool log, typename MessageWriter>
+    [[noreturn]] OPM_THROW_NOINLINE
+    void throwError(const char* file, int line, MessageWriter&& writer)
+    {
+        std::ostringstream oss__;
+        oss__ << "[" << file << ":" << line << "] ";
+        writer(oss__);
+        const std::string message = oss__.str();
+        if (log)
+            Opm::OpmLog::error(message);
+        throw Exception(message);
+    }
+
+}
+}
+
 // Macro to throw an exception. NOTE: For this macro to work, the
 // exception class must exhibit a constructor with the signature
 // (const std::string &message). Since this condition is not fulfilled
@@ -50,22 +82,15 @@
 //
 // Usage: OPM_THROW(ExceptionClass, "Error message " << value);
 #define OPM_THROW(Exception, message)                                   \
-    do {                                                                \
-        std::ostringstream oss__;                                       \
-        oss__ << "[" << __FILE__ << ":" << __LINE__ << "] " << message; \
-        Opm::OpmLog::error(oss__.str());                                \
-        throw Exception(oss__.str());                                   \
-    } while (false)
+    ::Opm::detail::throwError<Exception, true>(__FILE__, __LINE__,      \
+        [&](std::ostream& oss__) { oss__ << message; })
 
 // Same as OPM_THROW, except for not making an OpmLog::error() call.
 //
 // Usage: OPM_THROW_NOLOG(ExceptionClass, "Error message " << value);
 #define OPM_THROW_NOLOG(Exception, message)                             \
-    do {                                                                \
-        std::ostringstream oss__;                                       \
-        oss__ << "[" << __FILE__ << ":" << __LINE__ << "] " << message; \
-        throw Exception(oss__.str());                                   \
-    } while (false)
+    ::Opm::detail::throwError<Exception, false>(__FILE__, __LINE__,     \
+        [&](std::ostream& oss__) { oss__ << message; })
 
 // throw an exception if a condition is true
 #define OPM_ERROR_IF(condition, message) do {if(condition){ OPM_THROW(std::logic_error, message);}} while(false)
@@ -0,0 +1,153 @@
+/*
+  Copyright 2016 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <cstring>
+#include <stdexcept>
+
+#include <opm/common/OpmLog/AggregatingLog.hpp>
+
+namespace Opm {
+
+namespace {
+
+    /*
+      The pack format is a sequence of records:
+
+        [ uint64 message_type | uint64 count |
+          uint32 tag_size | tag bytes |
+          uint32 message_size | message bytes ]
+    */
+
+    template <typename T>
+    void appendInt( std::string& buffer , T value ) {
+        char bytes[ sizeof value ];
+        memcpy( bytes , &value , sizeof value );
+        buffer.append( bytes , sizeof value );
+    }
+
+    template <typename T>
+    bool readInt( const std::string& data , size_t& offset , T& value ) {
+        if (offset + sizeof value > data.size())
+            return false;
+        memcpy( &value , data.data() + offset , sizeof value );
+        offset += sizeof value;
+        return true;
+    }
+
+    bool readString( const std::string& data , size_t& offset , std::string& value ) {
+        uint32_t size;
+        if (!readInt<uint32_t>( data , offset , size ))
+            return false;
+        if (offset + size > data.size())
+            return false;
+        value = data.substr( offset , size );
+        offset += size;
+        return true;
+    }
+}
+
+
+AggregatingLog::AggregatingLog(std::shared_ptr<LogBackend> sink , int64_t messageMask) :
+    LogBackend( messageMask ),
+    m_sink( sink )
+{
+    if (!m_sink)
+        throw std::invalid_argument("The AggregatingLog backend requires a sink backend");
+}
+
+
+void AggregatingLog::insertRecord(int64_t messageType, const std::string& tag, const std::string& message, uint64_t count) {
+    std::string key;
+    appendInt<int64_t>( key , messageType );
+    appendInt<uint32_t>( key , uint32_t( tag.size() ));
+    key += tag;
+    key += message;
+
+    auto iter = m_index.find( key );
+    if (iter == m_index.end()) {
+        m_index.insert( { key , m_records.size() } );
+        m_records.push_back( { messageType , tag , message , count } );
+    } else
+        m_records[ iter->second ].count += count;
+}
+
+
+void AggregatingLog::addTaggedMessageUnconditionally(int64_t messageType, const std::string& tag, const std::string& message) {
+    insertRecord( messageType , tag , message , 1 );
+}
+
+
+void AggregatingLog::addMessageUnconditionally(int64_t messageType, const std::string& message) {
+    insertRecord( messageType , "" , message , 1 );
+}
+
+
+void AggregatingLog::flush() {
+    for (const Record& record : m_records) {
+        if (record.count == 1)
+            m_sink->addTaggedMessage( record.message_type , record.tag , record.message );
+        else
+            m_sink->addTaggedMessage( record.message_type , record.tag ,
+                                      record.message + " (" + std::to_string( record.count ) + " occurrences)" );
+    }
+    m_records.clear();
+    m_index.clear();
+    m_sink->flush();
+}
+
+
+std::string AggregatingLog::packRecords() const {
+    std::string packed;
+    for (const Record& record : m_records) {
+        appendInt<uint64_t>( packed , uint64_t( record.message_type ));
+        appendInt<uint64_t>( packed , record.count );
+        appendInt<uint32_t>( packed , uint32_t( record.tag.size() ));
+        packed += record.tag;
+        appendInt<uint32_t>( packed , uint32_t( record.message.size() ));
+        packed += record.message;
+    }
+    return packed;
+}
+
+
+void AggregatingLog::mergeRecords(const std::string& packed) {
+    size_t offset = 0;
+    while (offset < packed.size()) {
+        uint64_t message_type , count;
+        std::string tag , message;
+        if (!readInt<uint64_t>( packed , offset , message_type ) ||
+            !readInt<uint64_t>( packed , offset , count ) ||
+            !readString( packed , offset , tag ) ||
+            !readString( packed , offset , message ))
+            throw std::invalid_argument("Invalid packed log records");
+
+        insertRecord( int64_t( message_type ) , tag , message , count );
+    }
+}
+
+
+size_t AggregatingLog::numRecords() const {
+    return m_records.size();
+}
+
+
+AggregatingLog::~AggregatingLog() {
+    flush();
+}
+
+} // namespace Opm
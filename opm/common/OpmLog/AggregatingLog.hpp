@@ -0,0 +1,98 @@
+/*
+  Copyright 2016 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_AGGREGATINGLOG_HPP
+#define OPM_AGGREGATINGLOG_HPP
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <opm/common/OpmLog/LogBackend.hpp>
+
+namespace Opm {
+
+/*
+  The AggregatingLog backend buffers messages instead of writing
+  them: identical (type, tag, message) records are collapsed into a
+  single record with an occurrence count, and flush() emits each
+  distinct record once - annotated with the count when it is larger
+  than one - to a wrapped sink backend. This is the cure for the
+  pattern where every subdomain produces the same CFL warning and
+  the log drowns in hundreds of identical lines.
+
+  In a distributed run each process keeps its own AggregatingLog;
+  packRecords() serializes the buffered records to a byte blob which
+  can be shipped to an I/O process with whatever transport the
+  application uses, merged there with mergeRecords(), and written as
+  one deduplicated file. This library is communication-agnostic, so
+  the gather itself is the caller's responsibility.
+
+  The backend plugs into Logger::addBackend() like any other, and a
+  MessageLimiter set on it applies process-locally before messages
+  enter the buffer.
+*/
+
+class AggregatingLog : public LogBackend {
+
+public:
+    AggregatingLog(std::shared_ptr<LogBackend> sink , int64_t messageMask);
+    ~AggregatingLog();
+
+    /// Emit the buffered records to the sink - each distinct
+    /// (type, tag, message) once, in first-seen order - and clear
+    /// the buffer.
+    void flush() override;
+
+    /// Serialize the buffered records to a byte blob for transport
+    /// to another process.
+    std::string packRecords() const;
+
+    /// Merge a blob from packRecords() - typically produced on
+    /// another process - into the buffered records, adding up the
+    /// occurrence counts. Throws std::invalid_argument if the blob
+    /// is malformed.
+    void mergeRecords(const std::string& packed);
+
+    /// The number of distinct buffered records.
+    size_t numRecords() const;
+
+protected:
+    void addMessageUnconditionally(int64_t messageType, const std::string& message) override;
+    void addTaggedMessageUnconditionally(int64_t messageType, const std::string& tag, const std::string& message) override;
+
+private:
+    struct Record {
+        int64_t message_type;
+        std::string tag;
+        std::string message;
+        uint64_t count;
+    };
+
+    void insertRecord(int64_t messageType, const std::string& tag, const std::string& message, uint64_t count);
+
+    std::shared_ptr<LogBackend> m_sink;
+    std::vector<Record> m_records;
+    std::map<std::string , size_t> m_index;
+};
+}
+
+#endif
@@ -0,0 +1,185 @@
+/*
+  Copyright 2016 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <opm/common/OpmLog/BinaryLog.hpp>
+#include <opm/common/OpmLog/LogUtil.hpp>
+
+namespace Opm {
+
+namespace {
+
+    /*
+      File layout: the eight byte magic, followed by length-prefixed
+      records. Each record is a uint32 payload size and then the
+      payload, which starts with a one byte record kind:
+
+        tag definition: [ uint8 kind=0 | uint32 tag_id | tag bytes ]
+        message:        [ uint8 kind=1 | uint64 timestamp_us |
+                          uint64 message_type | uint32 tag_id |
+                          message bytes ]
+
+      All integers are in native byte order; tag id 0 means no tag,
+      and every other tag id is defined by a tag-definition record
+      earlier in the file.
+    */
+    const char binlog_magic[8] = { 'O' , 'P' , 'M' , 'B' , 'L' , 'O' , 'G' , '1' };
+    const uint8_t record_tag_def = 0;
+    const uint8_t record_message = 1;
+
+    template <typename T>
+    void appendInt( std::string& buffer , T value ) {
+        char bytes[ sizeof value ];
+        memcpy( bytes , &value , sizeof value );
+        buffer.append( bytes , sizeof value );
+    }
+
+    template <typename T>
+    bool readInt( const std::string& data , size_t& offset , T& value ) {
+        if (offset + sizeof value > data.size())
+            return false;
+        memcpy( &value , data.data() + offset , sizeof value );
+        offset += sizeof value;
+        return true;
+    }
+}
+
+
+BinaryLog::BinaryLog(const std::string& logFile , int64_t messageMask, bool append) : LogBackend(messageMask)
+{
+    if (append)
+        m_ofstream.open( logFile.c_str() , std::ofstream::app | std::ofstream::binary );
+    else
+        m_ofstream.open( logFile.c_str() , std::ofstream::out | std::ofstream::binary );
+
+    if (!m_ofstream)
+        throw std::invalid_argument("Failed to open binary log file: " + logFile);
+
+    if (m_ofstream.tellp() == std::ofstream::pos_type(0))
+        m_ofstream.write( binlog_magic , sizeof binlog_magic );
+}
+
+
+uint32_t BinaryLog::tagID(const std::string& tag) {
+    if (tag.empty())
+        return 0;
+
+    auto iter = m_tags.find( tag );
+    if (iter != m_tags.end())
+        return iter->second;
+
+    const uint32_t tag_id = uint32_t( m_tags.size() ) + 1;
+    m_tags.insert( { tag , tag_id } );
+
+    std::string payload;
+    payload.push_back( char( record_tag_def ));
+    appendInt<uint32_t>( payload , tag_id );
+    payload += tag;
+
+    const uint32_t size = uint32_t( payload.size() );
+    m_ofstream.write( reinterpret_cast<const char*>( &size ) , sizeof size );
+    m_ofstream.write( payload.data() , payload.size() );
+    return tag_id;
+}
+
+
+void BinaryLog::addTaggedMessageUnconditionally(int64_t messageType, const std::string& tag, const std::string& message) {
+    const uint32_t tag_id = tagID( tag );
+    const uint64_t timestamp_us =
+        std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::system_clock::now().time_since_epoch() ).count();
+
+    std::string payload;
+    payload.reserve( 1 + 2 * sizeof( uint64_t ) + sizeof( uint32_t ) + message.size() );
+    payload.push_back( char( record_message ));
+    appendInt<uint64_t>( payload , timestamp_us );
+    appendInt<uint64_t>( payload , uint64_t( messageType ));
+    appendInt<uint32_t>( payload , tag_id );
+    payload += message;
+
+    const uint32_t size = uint32_t( payload.size() );
+    m_ofstream.write( reinterpret_cast<const char*>( &size ) , sizeof size );
+    m_ofstream.write( payload.data() , payload.size() );
+}
+
+
+void BinaryLog::addMessageUnconditionally(int64_t messageType, const std::string& message) {
+    addTaggedMessageUnconditionally( messageType , "" , message );
+}
+
+
+void BinaryLog::flush() {
+    m_ofstream.flush();
+}
+
+
+BinaryLog::~BinaryLog() {
+    m_ofstream.flush();
+}
+
+
+//static:
+void BinaryLog::convertToText(const std::string& logFile , std::ostream& os) {
+    std::ifstream stream( logFile.c_str() , std::ifstream::binary );
+    if (!stream)
+        throw std::invalid_argument("Failed to open binary log file: " + logFile);
+
+    std::string data( (std::istreambuf_iterator<char>( stream )) , std::istreambuf_iterator<char>() );
+    if (data.size() < sizeof binlog_magic || memcmp( data.data() , binlog_magic , sizeof binlog_magic ) != 0)
+        throw std::invalid_argument("The file: " + logFile + " is not a binary log file");
+
+    size_t offset = sizeof binlog_magic;
+    while (true) {
+        uint32_t size;
+        if (!readInt<uint32_t>( data , offset , size ))
+            break;
+        if (size < 1 || offset + size > data.size())
+            break;
+
+        const size_t record_end = offset + size;
+        uint8_t kind;
+        if (!readInt<uint8_t>( data , offset , kind ))
+            break;
+
+        if (kind == record_message) {
+            uint64_t timestamp_us , message_type;
+            uint32_t tag_id;
+            if (readInt<uint64_t>( data , offset , timestamp_us ) &&
+                readInt<uint64_t>( data , offset , message_type ) &&
+                readInt<uint32_t>( data , offset , tag_id )) {
+                const std::string message = data.substr( offset , record_end - offset );
+                /*
+                  Custom message types registered with a Logger have
+                  no built-in prefix; emit such messages verbatim
+                  instead of letting prefixMessage() throw.
+                */
+                if (Log::isPower2( int64_t( message_type )) && (int64_t( message_type ) & Log::DefaultMessageTypes))
+                    os << Log::prefixMessage( int64_t( message_type ) , message ) << '\n';
+                else
+                    os << message << '\n';
+            }
+        }
+        /* Tag-definition records carry no text output. */
+        offset = record_end;
+    }
+}
+
+} // namespace Opm
@@ -28,34 +28,149 @@
 
 namespace Opm {
 
-CounterLog::CounterLog(int64_t messageTypes) : LogBackend(messageTypes)
-{ }
+namespace {
+
+    /* Bit index of a power-of-2 message type. */
+    inline size_t typeIndex( int64_t messageType ) {
+        size_t index = 0;
+        uint64_t bits = uint64_t( messageType ) >> 1;
+        while (bits) {
+            bits >>= 1;
+            index++;
+        }
+        return index;
+    }
+
+    /* 64 bit FNV-1a; never returns 0 since that marks an empty
+       table slot. */
+    uint64_t hashTag( const std::string& tag ) {
+        uint64_t hash = 14695981039346656037ULL;
+        for (char c : tag) {
+            hash ^= uint64_t( static_cast<unsigned char>( c ));
+            hash *= 1099511628211ULL;
+        }
+        return hash ? hash : 1;
+    }
+
+    /* Linear probing over a power-of-2 table of slots carrying an
+       atomic hash member; claims an empty slot with a CAS when
+       inserting. Returns -1 when the tag is absent (lookup) or the
+       table is full (insert). */
+    template <typename Slot>
+    int findSlot( Slot* table , size_t table_size , uint64_t hash , bool insert ) {
+        const size_t mask = table_size - 1;
+        for (size_t probe = 0; probe < table_size; probe++) {
+            const size_t index = (hash + probe) & mask;
+            uint64_t slot_hash = table[ index ].hash.load( std::memory_order_acquire );
+            if (slot_hash == 0) {
+                if (!insert)
+                    return -1;
+                if (table[ index ].hash.compare_exchange_strong( slot_hash , hash , std::memory_order_acq_rel ))
+                    return int( index );
+                /* slot_hash now holds the winning value. */
+            }
+            if (slot_hash == hash)
+                return int( index );
+        }
+        return -1;
+    }
+}
+
+
+CounterLog::CounterLog(int64_t messageTypes) :
+    LogBackend(messageTypes),
+    m_events( new EventSlot[ event_table_size ] ),
+    m_histograms( new HistogramSlot[ histogram_table_size ] )
+{
+    clear();
+}
 
-CounterLog::CounterLog() : LogBackend(Log::DefaultMessageTypes)
+CounterLog::CounterLog() : CounterLog(Log::DefaultMessageTypes)
 { }
 
 
 size_t CounterLog::numMessages(int64_t messageType) const {
-    if (Log::isPower2( messageType )) {
-        auto iter = m_count.find( messageType );
-        if (iter == m_count.end())
-            return 0;
-        else
-            return (*iter).second;
-    } else
+    if (Log::isPower2( messageType ))
+        return m_count[ typeIndex( messageType ) ].value.load( std::memory_order_relaxed );
+    else
         throw std::invalid_argument("The messageType ID must be 2^n");
 }
 
 
+int CounterLog::findEventSlot(uint64_t hash, bool insert) const {
+    return findSlot<EventSlot>( m_events.get() , event_table_size , hash , insert );
+}
+
+int CounterLog::findHistogramSlot(uint64_t hash, bool insert) const {
+    return findSlot<HistogramSlot>( m_histograms.get() , histogram_table_size , hash , insert );
+}
+
+
+void CounterLog::countEvent(const std::string& tag) {
+    const int slot = findEventSlot( hashTag( tag ) , true );
+    if (slot >= 0)
+        m_events[ slot ].count.value.fetch_add( 1 , std::memory_order_relaxed );
+}
+
+
+size_t CounterLog::numEvents(const std::string& tag) const {
+    const int slot = findEventSlot( hashTag( tag ) , false );
+    if (slot >= 0)
+        return m_events[ slot ].count.value.load( std::memory_order_relaxed );
+    return 0;
+}
+
+
+void CounterLog::recordLatency(const std::string& tag, double seconds) {
+    const int slot = findHistogramSlot( hashTag( tag ) , true );
+    if (slot < 0)
+        return;
+
+    const double micro_seconds = seconds * 1e6;
+    size_t bucket = 0;
+    uint64_t value = (micro_seconds > 1) ? uint64_t( micro_seconds ) : 0;
+    while (value > 1) {
+        value >>= 1;
+        bucket++;
+    }
+    if (bucket >= num_latency_buckets)
+        bucket = num_latency_buckets - 1;
+
+    m_histograms[ slot ].buckets[ bucket ].fetch_add( 1 , std::memory_order_relaxed );
+}
+
+
+std::vector<size_t> CounterLog::latencyHistogram(const std::string& tag) const {
+    std::vector<size_t> histogram( num_latency_buckets , 0 );
+    const int slot = findHistogramSlot( hashTag( tag ) , false );
+    if (slot >= 0) {
+        for (size_t bucket = 0; bucket < num_latency_buckets; bucket++)
+            histogram[ bucket ] = m_histograms[ slot ].buckets[ bucket ].load( std::memory_order_relaxed );
+    }
+    return histogram;
+}
+
 
 void CounterLog::addMessageUnconditionally(int64_t messageType, const std::string& ) {
-    m_count[messageType]++;
+    m_count[ typeIndex( messageType ) ].value.fetch_add( 1 , std::memory_order_relaxed );
 }
 
 
 void CounterLog::clear()
 {
-    m_count.clear();
+    for (size_t i = 0; i < num_message_types; i++)
+        m_count[i].value.store( 0 , std::memory_order_relaxed );
+
+    for (size_t i = 0; i < event_table_size; i++) {
+        m_events[i].hash.store( 0 , std::memory_order_relaxed );
+        m_events[i].count.value.store( 0 , std::memory_order_relaxed );
+    }
+
+    for (size_t i = 0; i < histogram_table_size; i++) {
+        m_histograms[i].hash.store( 0 , std::memory_order_relaxed );
+        for (auto& bucket : m_histograms[i].buckets)
+            bucket.store( 0 , std::memory_order_relaxed );
+    }
 }
 
 
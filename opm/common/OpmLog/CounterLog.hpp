@@ -19,9 +19,12 @@
 #ifndef OPM_COUNTERLOG_HPP
 #define OPM_COUNTERLOG_HPP
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <memory>
-#include <map>
+#include <vector>
 
 #include <opm/common/OpmLog/LogBackend.hpp>
 
@@ -29,25 +32,80 @@ namespace Opm {
 /*!
  * \brief Provides a simple sytem for log message which are found by the
  *        Parser/Deck/EclipseState classes during processing the deck.
+ *
+ * The counters are lock free: the per-message-type counts live in a
+ * fixed array of cache-line-padded atomics indexed by the type bit,
+ * and the per-tag event counts and log-scale latency histograms live
+ * in fixed open-addressing tables where a tag is identified by its
+ * 64 bit FNV-1a hash. Recording an event costs one relaxed atomic
+ * increment, so the backend can stay enabled in production and be
+ * scraped from a live run by monitoring.
  */
     class CounterLog : public LogBackend
     {
     public:
+        /// Latency histogram bucket i counts samples with a latency
+        /// in [2^i , 2^(i+1)) microseconds.
+        static const size_t num_latency_buckets = 64;
+
         CounterLog(int64_t messageMask);
         CounterLog();
 
         size_t numMessages(int64_t messageType) const;
 
+        /// Count one occurrence of the event @tag - one relaxed
+        /// atomic increment.
+        void countEvent(const std::string& tag);
+
+        /// The number of countEvent() calls for @tag.
+        size_t numEvents(const std::string& tag) const;
+
+        /// Add one latency sample for @tag to the log-scale
+        /// histogram.
+        void recordLatency(const std::string& tag, double seconds);
+
+        /// The latency histogram for @tag - all zero if no samples
+        /// have been recorded.
+        std::vector<size_t> latencyHistogram(const std::string& tag) const;
+
         void clear();
 
     protected:
         void addMessageUnconditionally(int64_t messageFlag,
                                        const std::string& message) override;
     private:
-        std::map<int64_t , size_t> m_count;
+        static const size_t num_message_types = 64;
+        static const size_t event_table_size = 1024;
+        static const size_t histogram_table_size = 256;
+
+        /// One counter per 64 byte cache line. The padding is
+        /// explicit rather than alignas(64) because C++11 operator
+        /// new[] does not honor extended alignment; with 64 bytes
+        /// between them no two counters can share a line regardless
+        /// of where the allocation starts.
+        struct PaddedCounter {
+            std::atomic<size_t> value;
+            char padding[ 64 - sizeof(std::atomic<size_t>) ];
+        };
+
+        struct EventSlot {
+            std::atomic<uint64_t> hash;
+            PaddedCounter count;
+        };
+
+        struct HistogramSlot {
+            std::atomic<uint64_t> hash;
+            std::array<std::atomic<size_t>, num_latency_buckets> buckets;
+        };
+
+        int findEventSlot(uint64_t hash, bool insert) const;
+        int findHistogramSlot(uint64_t hash, bool insert) const;
+
+        std::array<PaddedCounter, num_message_types> m_count;
+        std::unique_ptr<EventSlot[]> m_events;
+        std::unique_ptr<HistogramSlot[]> m_histograms;
     };
 
 } // namespace Opm
 
 #endif
-
@@ -64,8 +64,9 @@ namespace Opm {
     EclipsePRTLog::EclipsePRTLog(const std::string& logFile,
                                  int64_t messageMask,
                                  bool append,
-                                 bool print_summary)
-        : StreamLog(logFile, messageMask, append),
+                                 bool print_summary,
+                                 bool compress)
+        : StreamLog(logFile, messageMask, append, compress),
           print_summary_(print_summary)
     {}
 
@@ -41,8 +41,10 @@ public:
     /// \param append If true then we append messages to the file.
     ///               Otherwise a new file is created.
     /// \param print_summary If true print a summary to the PRT file.
+    /// \param compress If true the file is written gzip compressed -
+    ///                 see StreamLog for the compression behaviour.
     EclipsePRTLog(const std::string& logFile , int64_t messageMask,
-                  bool append, bool print_summary);
+                  bool append, bool print_summary, bool compress = false);
 
     /// \brief Construct a logger to the <MODLE>.PRT file
     /// \param logFile The name of the logfile to use.
@@ -49,15 +49,24 @@ namespace Opm {
 
     void LogBackend::addTaggedMessage(int64_t messageType, const std::string& messageTag, const std::string& message) {
         if (includeMessage( messageType, messageTag )) {
-            addMessageUnconditionally(messageType, message);
+            addTaggedMessageUnconditionally(messageType, messageTag, message);
         }
     }
 
+    void LogBackend::addTaggedMessageUnconditionally(int64_t messageFlag, const std::string& /* messageTag */, const std::string& message)
+    {
+        addMessageUnconditionally(messageFlag, message);
+    }
+
     int64_t LogBackend::getMask() const
     {
         return m_mask;
     }
 
+    void LogBackend::flush()
+    {
+    }
+
     bool LogBackend::includeMessage(int64_t messageFlag, const std::string& messageTag)
     {
         // Check mask.
@@ -94,5 +103,20 @@ namespace Opm {
         }
     }
 
+    void LogBackend::formatMessage(int64_t messageFlag, const std::string& message, std::string& buffer)
+    {
+        if (m_formatter) {
+            m_formatter->formatTo(messageFlag, message, buffer);
+        } else {
+            buffer += message;
+        }
+    }
+
+    std::string& LogBackend::formatBuffer()
+    {
+        m_format_buffer.clear();
+        return m_format_buffer;
+    }
+
 
 }
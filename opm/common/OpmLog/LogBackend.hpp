@@ -59,6 +59,11 @@ namespace Opm
         /// Opm::Log::MessageType namespace, in file LogUtils.hpp.
         int64_t getMask() const;
 
+        /// Write out any internally buffered messages. The default
+        /// implementation does nothing; backends which buffer -
+        /// like StreamLog with a buffering policy - override this.
+        virtual void flush();
+
     protected:
         /// This is the method subclasses should override.
         ///
@@ -67,9 +72,27 @@ namespace Opm
         virtual void addMessageUnconditionally(int64_t messageFlag,
                                                const std::string& message) = 0;
 
+        /// Tagged variant of addMessageUnconditionally(); backends
+        /// which record the tag - like BinaryLog - override this
+        /// one. The default implementation drops the tag and
+        /// forwards to addMessageUnconditionally().
+        virtual void addTaggedMessageUnconditionally(int64_t messageFlag,
+                                                     const std::string& messageTag,
+                                                     const std::string& message);
+
         /// Return decorated version of message depending on configureDecoration() arguments.
         std::string formatMessage(int64_t messageFlag, const std::string& message);
 
+        /// Appending variant of formatMessage(): the decorated
+        /// message goes into @buffer with no temporary strings.
+        void formatMessage(int64_t messageFlag, const std::string& message, std::string& buffer);
+
+        /// A reusable scratch buffer for the formatted message -
+        /// cleared on every call, but the capacity is kept, so a
+        /// backend formatting through it stops allocating once the
+        /// buffer has grown to the size of the largest message.
+        std::string& formatBuffer();
+
     private:
         /// Return true if all bits of messageFlag are also set in our mask,
         /// and the message limiter returns a PrintMessage response.
@@ -78,6 +101,7 @@ namespace Opm
         int64_t m_mask;
         std::shared_ptr<MessageFormatterInterface> m_formatter;
         std::shared_ptr<MessageLimiter> m_limiter;
+        std::string m_format_buffer;
     };
 
 } // namespace LogBackend
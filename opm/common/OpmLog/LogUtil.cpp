@@ -45,8 +45,8 @@ namespace Log {
     }
 
 
-    std::string prefixMessage(int64_t messageType, const std::string& message) {
-        std::string prefix;
+    void prefixMessage(int64_t messageType, const std::string& message, std::string& buffer) {
+        const char* prefix;
         switch (messageType) {
         case MessageType::Debug:
             prefix = "Debug";
@@ -73,26 +73,50 @@ namespace Log {
             throw std::invalid_argument("Unhandled messagetype");
         }
 
-        return prefix + ": " + message;
+        buffer += prefix;
+        buffer += ": ";
+        buffer += message;
     }
 
 
-    std::string colorCodeMessage(int64_t messageType, const std::string& message) {
+    std::string prefixMessage(int64_t messageType, const std::string& message) {
+        std::string result;
+        prefixMessage( messageType , message , result );
+        return result;
+    }
+
+
+    const std::string& colorPrefix(int64_t messageType) {
+        static const std::string no_color = "";
         switch (messageType) {
         case MessageType::Debug:
         case MessageType::Note:
         case MessageType::Info:
-            return message; // No color coding, not even the code for default color.
+            return no_color; // No color coding, not even the code for default color.
         case MessageType::Warning:
-            return AnsiTerminalColors::blue_strong + message + AnsiTerminalColors::none;
+            return AnsiTerminalColors::blue_strong;
         case MessageType::Error:
         case MessageType::Problem:
         case MessageType::Bug:
-            return AnsiTerminalColors::red_strong + message + AnsiTerminalColors::none;
+            return AnsiTerminalColors::red_strong;
         default:
             throw std::invalid_argument("Unhandled messagetype");
         }
     }
 
+
+    const std::string& colorSuffix(int64_t messageType) {
+        static const std::string no_color = "";
+        if (colorPrefix( messageType ).empty())
+            return no_color;
+        else
+            return AnsiTerminalColors::none;
+    }
+
+
+    std::string colorCodeMessage(int64_t messageType, const std::string& message) {
+        return colorPrefix( messageType ) + message + colorSuffix( messageType );
+    }
+
 }
 }
@@ -59,6 +59,17 @@ namespace Log {
     std::string prefixMessage(int64_t messageType , const std::string& msg);
     std::string colorCodeMessage(int64_t messageType , const std::string& msg);
 
+    /// Appending variants for allocation-free formatting: the
+    /// decorated message is appended to an existing buffer instead
+    /// of being returned as a fresh string. colorPrefix() and
+    /// colorSuffix() return the ANSI codes bracketing a message of
+    /// the given type - empty strings for the uncolored types - so
+    /// a caller can append code, content and reset without building
+    /// temporaries.
+    void prefixMessage(int64_t messageType , const std::string& msg , std::string& buffer);
+    const std::string& colorPrefix(int64_t messageType);
+    const std::string& colorSuffix(int64_t messageType);
+
 }
 }
 
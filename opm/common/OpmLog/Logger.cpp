@@ -16,9 +16,12 @@
   You should have received a copy of the GNU General Public License
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include <atomic>
 #include <sstream>
 #include <stdexcept>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include <opm/common/OpmLog/LogBackend.hpp>
 #include <opm/common/OpmLog/Logger.hpp>
@@ -26,6 +29,128 @@
 
 namespace Opm {
 
+    namespace {
+        /* Bit index of a power-of-2 message type. */
+        inline size_t typeIndex( int64_t messageType ) {
+            size_t index = 0;
+            uint64_t bits = uint64_t( messageType ) >> 1;
+            while (bits) {
+                bits >>= 1;
+                index++;
+            }
+            return index;
+        }
+    }
+
+    /*
+      The asynchronous mode is built on a bounded lock-free
+      multi-producer queue in the style of Vyukov's bounded MPMC
+      queue: each cell carries a sequence number which tells both
+      sides whether the cell is free to write or ready to read, so
+      producers only contend on one atomic counter. The consumer side
+      is the single background thread, which performs the actual
+      backend delivery and counts completed messages so that flush()
+      can implement a true barrier.
+    */
+    struct Logger::AsyncLog {
+        struct Cell {
+            std::atomic<size_t> sequence;
+            int64_t message_type;
+            std::string tag;
+            std::string message;
+        };
+
+        AsyncLog(const Logger& logger, size_t queue_size) :
+            m_logger( logger ),
+            m_enqueue_pos( 0 ),
+            m_dequeue_pos( 0 ),
+            m_delivered( 0 ),
+            m_running( true )
+        {
+            size_t size = 1;
+            while (size < queue_size)
+                size *= 2;
+            m_mask = size - 1;
+
+            m_cells.reset( new Cell[ size ] );
+            for (size_t i = 0; i < size; i++)
+                m_cells[i].sequence.store( i , std::memory_order_relaxed );
+
+            m_worker = std::thread( [this] { this->run(); } );
+        }
+
+        ~AsyncLog() {
+            m_running.store( false );
+            m_worker.join();
+        }
+
+        void enqueue(int64_t messageType, const std::string& tag, const std::string& message) {
+            size_t pos = m_enqueue_pos.load( std::memory_order_relaxed );
+            for (;;) {
+                Cell& cell = m_cells[ pos & m_mask ];
+                size_t sequence = cell.sequence.load( std::memory_order_acquire );
+                intptr_t diff = intptr_t( sequence ) - intptr_t( pos );
+
+                if (diff == 0) {
+                    if (m_enqueue_pos.compare_exchange_weak( pos , pos + 1 , std::memory_order_relaxed ))
+                        break;
+                } else if (diff < 0) {
+                    // The ring is full: back off until the consumer
+                    // has caught up - messages are never dropped.
+                    std::this_thread::yield();
+                    pos = m_enqueue_pos.load( std::memory_order_relaxed );
+                } else
+                    pos = m_enqueue_pos.load( std::memory_order_relaxed );
+            }
+
+            Cell& cell = m_cells[ pos & m_mask ];
+            cell.message_type = messageType;
+            cell.tag = tag;
+            cell.message = message;
+            cell.sequence.store( pos + 1 , std::memory_order_release );
+        }
+
+        void flush() const {
+            const size_t target = m_enqueue_pos.load();
+            while (m_delivered.load() < target)
+                std::this_thread::yield();
+        }
+
+    private:
+        void run() {
+            while (true) {
+                Cell& cell = m_cells[ m_dequeue_pos & m_mask ];
+                size_t sequence = cell.sequence.load( std::memory_order_acquire );
+
+                if (intptr_t( sequence ) - intptr_t( m_dequeue_pos + 1 ) < 0) {
+                    // Empty; exit only after a final drain so that
+                    // the destructor delivers everything enqueued.
+                    if (!m_running.load())
+                        return;
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                m_logger.deliverMessage( cell.message_type , cell.tag , cell.message );
+                cell.tag.clear();
+                cell.message.clear();
+                cell.sequence.store( m_dequeue_pos + m_mask + 1 , std::memory_order_release );
+                m_dequeue_pos++;
+                m_delivered.fetch_add( 1 );
+            }
+        }
+
+        const Logger& m_logger;
+        std::unique_ptr<Cell[]> m_cells;
+        size_t m_mask;
+        std::atomic<size_t> m_enqueue_pos;
+        size_t m_dequeue_pos;
+        std::atomic<size_t> m_delivered;
+        std::atomic<bool> m_running;
+        std::thread m_worker;
+    };
+
+
     Logger::Logger()
         : m_globalMask(0),
           m_enabledTypes(0)
@@ -39,15 +164,22 @@ namespace Opm {
         addMessageType( Log::MessageType::Note , "note");
     }
 
+    Logger::~Logger() = default;
+
+    void Logger::deliverMessage(int64_t messageType, const std::string& tag, const std::string& message) const {
+        for (LogBackend* backend : m_dispatch[ typeIndex( messageType ) ])
+            backend->addTaggedMessage( messageType, tag, message );
+    }
+
     void Logger::addTaggedMessage(int64_t messageType, const std::string& tag, const std::string& message) const {
         if ((m_enabledTypes & messageType) == 0)
             throw std::invalid_argument("Tried to issue message with unrecognized message ID");
 
         if (m_globalMask & messageType) {
-            for (auto iter : m_backends) {
-                LogBackend& backend = *(iter.second);
-                backend.addTaggedMessage( messageType, tag, message );
-            }
+            if (m_async)
+                m_async->enqueue( messageType, tag, message );
+            else
+                deliverMessage( messageType, tag, message );
         }
     }
 
@@ -56,8 +188,38 @@ namespace Opm {
     }
 
 
-    void Logger::updateGlobalMask( int64_t mask ) {
-        m_globalMask |= mask;
+    void Logger::setAsync(size_t queue_size) {
+        if (!m_async)
+            m_async.reset( new AsyncLog( *this , queue_size ));
+    }
+
+    void Logger::setSync() {
+        m_async.reset( );
+    }
+
+    bool Logger::async() const {
+        return bool( m_async );
+    }
+
+    void Logger::flush() const {
+        if (m_async)
+            m_async->flush();
+    }
+
+
+    void Logger::rebuildDispatch() {
+        m_globalMask = 0;
+        for (auto& list : m_dispatch)
+            list.clear();
+
+        for (auto& pair : m_backends) {
+            const uint64_t mask = uint64_t( pair.second->getMask() );
+            m_globalMask |= int64_t( mask );
+            for (size_t index = 0; index < num_message_types; index++) {
+                if (mask & (uint64_t(1) << index))
+                    m_dispatch[ index ].push_back( pair.second.get() );
+            }
+        }
     }
 
 
@@ -70,11 +232,12 @@ namespace Opm {
 
     void Logger::removeAllBackends() {
         m_backends.clear();
-        m_globalMask = 0;
+        rebuildDispatch();
     }
 
     bool Logger::removeBackend(const std::string& name) {
         size_t eraseCount = m_backends.erase( name );
+        rebuildDispatch();
         if (eraseCount == 1)
             return true;
         else
@@ -83,8 +246,8 @@ namespace Opm {
 
 
     void Logger::addBackend(const std::string& name , std::shared_ptr<LogBackend> backend) {
-        updateGlobalMask( backend->getMask() );
         m_backends[ name ] = backend;
+        rebuildDispatch();
     }
 
 
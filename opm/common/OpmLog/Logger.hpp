@@ -21,10 +21,14 @@
 #define OPM_LOGGER_HPP
 
 #include <stdexcept>
+#include <array>
 #include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace Opm {
 
@@ -34,9 +38,62 @@ class Logger {
 
 public:
     Logger();
+    ~Logger();
     void addMessage(int64_t messageType , const std::string& message) const;
     void addTaggedMessage(int64_t messageType, const std::string& tag, const std::string& message) const;
 
+    /// Lazy overloads: the message text is produced by a callable
+    /// which is invoked only if the message type passes the global
+    /// mask, i.e. if at least one backend will actually receive
+    /// it. Use these when building the message is itself expensive:
+    ///
+    ///    logger.addMessage( Log::MessageType::Debug , [&]() {
+    ///        return "Residual: " + std::to_string( residual ); });
+    ///
+    /// A suppressed category then costs a single masked integer
+    /// test and nothing else. The enable_if constraint keeps string
+    /// literals and std::string arguments on the eager overloads.
+    template <typename MessageBuilder, typename std::enable_if< !std::is_convertible<MessageBuilder, std::string>::value , int>::type = 0>
+    void addMessage(int64_t messageType , MessageBuilder&& builder) const {
+        this->addTaggedMessage( messageType , "" , std::forward<MessageBuilder>( builder ));
+    }
+
+    template <typename MessageBuilder, typename std::enable_if< !std::is_convertible<MessageBuilder, std::string>::value , int>::type = 0>
+    void addTaggedMessage(int64_t messageType , const std::string& tag , MessageBuilder&& builder) const {
+        if ((m_enabledTypes & messageType) == 0)
+            throw std::invalid_argument("Tried to issue message with unrecognized message ID");
+
+        if (m_globalMask & messageType)
+            this->addTaggedMessage( messageType , tag , std::string( builder() ));
+    }
+
+    /// Will switch the logger to asynchronous mode: addMessage()
+    /// only enqueues the (type, tag, message) record in a bounded
+    /// lock-free ring buffer and returns immediately, and a
+    /// background thread performs the formatting, limiting and I/O
+    /// in the backends. This decouples the simulation from disk
+    /// latency when e.g. a convergence problem produces a burst of
+    /// warnings. When the ring is full the producers back off until
+    /// the consumer has caught up - messages are never dropped. The
+    /// queue size is rounded up to a power of two.
+    ///
+    /// The set of backends must not be modified while asynchronous
+    /// mode is active; call setSync() - or flush() and then
+    /// reconfigure from the logging thread - first.
+    void setAsync(size_t queue_size = 1024);
+
+    /// Will drain the queue, stop the background thread and return
+    /// the logger to synchronous mode.
+    void setSync();
+
+    bool async() const;
+
+    /// Barrier: will block until every message enqueued before the
+    /// call has been completely delivered to the backends. Use this
+    /// before shutdown and in exception paths; a no-op in
+    /// synchronous mode.
+    void flush() const;
+
     static bool enabledDefaultMessageType( int64_t messageType);
     bool enabledMessageType( int64_t messageType) const;
     void addMessageType( int64_t messageType , const std::string& prefix);
@@ -70,12 +127,28 @@ public:
 
 
 private:
-    void updateGlobalMask( int64_t mask );
+    struct AsyncLog;
+
+    static const size_t num_message_types = 64;
+
+    void rebuildDispatch();
     static bool enabledMessageType( int64_t enabledTypes , int64_t messageType);
+    void deliverMessage(int64_t messageType, const std::string& tag, const std::string& message) const;
 
     int64_t m_globalMask;
     int64_t m_enabledTypes;
+
+    /*
+      The name -> backend map owns the backends and serves the
+      getBackend() / popBackend() lookups; message dispatch uses
+      m_dispatch, which holds one flat list per message type bit of
+      exactly the backends whose mask includes that type. The lists
+      are rebuilt by addBackend() / removeBackend(); the backend
+      mask is fixed at construction, so they can not go stale.
+    */
     std::map<std::string , std::shared_ptr<LogBackend> > m_backends;
+    std::array< std::vector<LogBackend*> , num_message_types > m_dispatch;
+    std::unique_ptr<AsyncLog> m_async;
 };
 
 }
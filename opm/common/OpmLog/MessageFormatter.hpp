@@ -37,6 +37,17 @@ namespace Opm
         /// input string, the formatting applied depending on the
         /// message_flag.
         virtual std::string format(const int64_t message_flag, const std::string& message) = 0;
+
+        /// Appending variant: write the formatted message into an
+        /// existing buffer instead of returning a fresh string, so
+        /// a backend can reuse one buffer across messages and skip
+        /// the per-message allocations. The default implementation
+        /// forwards to format(); allocation-conscious formatters
+        /// should override this one.
+        virtual void formatTo(const int64_t message_flag, const std::string& message, std::string& buffer)
+        {
+            buffer += format(message_flag, message);
+        }
     };
 
 
@@ -75,14 +86,26 @@ namespace Opm
         /// flag-dependent color (if use_color_coding).
         virtual std::string format(const int64_t message_flag, const std::string& message) override
         {
-            std::string msg = message;
+            std::string msg;
+            formatTo(message_flag, message, msg);
+            return msg;
+        }
+
+        /// Appends the decorated message to the buffer without
+        /// building any temporary strings.
+        virtual void formatTo(const int64_t message_flag, const std::string& message, std::string& buffer) override
+        {
+            if (use_color_coding_) {
+                buffer += Log::colorPrefix(message_flag);
+            }
             if (message_flag & prefix_flag_) {
-                msg = Log::prefixMessage(message_flag, msg);
+                Log::prefixMessage(message_flag, message, buffer);
+            } else {
+                buffer += message;
             }
             if (use_color_coding_) {
-                msg = Log::colorCodeMessage(message_flag, msg);
+                buffer += Log::colorSuffix(message_flag);
             }
-            return msg;
         }
     private:
         bool use_color_coding_ = false;
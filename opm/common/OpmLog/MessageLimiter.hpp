@@ -21,10 +21,13 @@
 #define OPM_MESSAGELIMITER_HEADER_INCLUDED
 
 #include <opm/common/OpmLog/LogUtil.hpp>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 
@@ -33,6 +36,20 @@ namespace Opm
 
 
     /// Handles limiting the number of messages with the same tag.
+    ///
+    /// This runs on every message that reaches a backend, so the
+    /// counting structures are kept flat: the per-category limits
+    /// and counts are dense arrays indexed by the bit position of
+    /// the message type, and the per-tag counts live in a fixed
+    /// size open-addressing hash table where a tag is identified by
+    /// its 64 bit FNV-1a hash - the string itself is never stored
+    /// or compared, so two distinct tags would share a count only
+    /// in the astronomically unlikely event of a full hash
+    /// collision. All counters are atomic; handleMessageLimits()
+    /// is lock-free and can be called from concurrent logging
+    /// threads. Callers which log with the same tag repeatedly -
+    /// well names, every iteration - can hash it once with
+    /// registerTag() and use the integer tag-id overload.
     class MessageLimiter
     {
     public:
@@ -52,19 +69,14 @@ namespace Opm
         /// NoLimit, but the default constructor is the preferred way
         /// to obtain that behaviour.
         explicit MessageLimiter(const int tag_limit)
-            : tag_limit_(tag_limit < 0 ? NoLimit : tag_limit),
-              category_limits_({{Log::MessageType::Note, NoLimit},
-                                {Log::MessageType::Info, NoLimit},
-                                {Log::MessageType::Warning, NoLimit},
-                                {Log::MessageType::Error, NoLimit},
-                                {Log::MessageType::Problem, NoLimit},
-                                {Log::MessageType::Bug, NoLimit}})
+            : MessageLimiter(tag_limit, {})
         {
         }
 
         MessageLimiter(const int tag_limit, const std::map<int64_t, int> category_limits)
             : tag_limit_(tag_limit < 0 ? NoLimit : tag_limit),
-              category_limits_(category_limits)
+              category_limits_(category_limits),
+              tag_table_(new TagSlot[tag_table_size])
         {
             // Must ensure NoLimit for categories that are not
             // explicitly specified in the input.
@@ -78,6 +90,18 @@ namespace Opm
                     category_limits_[category] = NoLimit;
                 }
             }
+
+            for (size_t i = 0; i < num_message_types; ++i) {
+                category_limit_[i] = NoLimit;
+                category_count_[i].store(0, std::memory_order_relaxed);
+            }
+            for (const auto& pair : category_limits_) {
+                category_limit_[typeIndex(pair.first)] = pair.second;
+            }
+            for (size_t i = 0; i < tag_table_size; ++i) {
+                tag_table_[i].hash.store(0, std::memory_order_relaxed);
+                tag_table_[i].count.store(0, std::memory_order_relaxed);
+            }
         }
 
         /// The tag message limit (same for all tags).
@@ -93,9 +117,21 @@ namespace Opm
         }
 
         /// The category message counts.
+        ///
+        /// Only consult this when no messages are in flight; the
+        /// returned view is rebuilt from the internal counters on
+        /// every call.
         const std::map<int64_t, int>& categoryMessageCounts() const
         {
-            return category_counts_;
+            for (auto category : { Log::MessageType::Note,
+                                   Log::MessageType::Info,
+                                   Log::MessageType::Warning,
+                                   Log::MessageType::Error,
+                                   Log::MessageType::Problem,
+                                   Log::MessageType::Bug }) {
+                category_counts_view_[category] = category_count_[typeIndex(category)].load(std::memory_order_relaxed);
+            }
+            return category_counts_view_;
         }
 
         /// Used for handleMessageLimits() return type (see that
@@ -105,6 +141,18 @@ namespace Opm
             PrintMessage, JustOverTagLimit, JustOverCategoryLimit, OverTagLimit, OverCategoryLimit
         };
 
+        /// Hash the tag once and obtain an integer id for the tag-id
+        /// overload of handleMessageLimits(). The empty tag - and a
+        /// tag that no longer fits in the table - maps to NoTag,
+        /// for which no tag limiting is applied.
+        enum { NoTag = -1 };
+        int registerTag(const std::string& tag)
+        {
+            if (tag.empty())
+                return NoTag;
+            return findSlot(hashTag(tag));
+        }
+
         /// If (tag count == tag limit + 1) for the passed tag, respond JustOverTagLimit.
         /// If (tag count > tag limit + 1), respond OverTagLimit.
         /// If a tag is empty, there is no tag message limit or for that tag
@@ -113,31 +161,34 @@ namespace Opm
         /// If (category count > category limit + 1), respond OverCategoryLimit.
         /// If (category count <= category limit), or there is no limit for that category, respond PrintMessage.
         Response handleMessageLimits(const std::string& tag, const int64_t messageMask)
+        {
+            int tag_id = NoTag;
+            if (!tag.empty() && tag_limit_ != NoLimit)
+                tag_id = findSlot(hashTag(tag));
+            return handleMessageLimits(tag_id, messageMask);
+        }
+
+        /// Fast path taking a tag id from registerTag() instead of
+        /// the tag string.
+        Response handleMessageLimits(const int tag_id, const int64_t messageMask)
         {
             Response res = Response::PrintMessage;
 
             // Deal with tag limits.
-            if (!tag.empty() && tag_limit_ != NoLimit) {
-                // See if tag already encountered.
-                auto it = tag_counts_.find(tag);
-                if (it != tag_counts_.end()) {
-                    // Already encountered this tag. Increment its count.
-                    const int count = ++it->second;
-                    res = countBasedResponseTag(count);
-                } else {
-                    // First encounter of this tag. Insert 1.
-                    tag_counts_.insert({tag, 1});
-                    res = countBasedResponseTag(1);
-                }
+            if (tag_id != NoTag && tag_limit_ != NoLimit) {
+                const int count = tag_table_[tag_id].count.fetch_add(1, std::memory_order_relaxed) + 1;
+                res = countBasedResponseTag(count);
             }
 
             // If tag count reached the limit, the message is not counted
             // towards the category limits.
             if (res == Response::PrintMessage) {
                 // We are *not* above the tag limit, consider category limit.
-                const int count = ++category_counts_[messageMask];
-                if (category_limits_[messageMask] != NoLimit) {
-                    res = countBasedResponseCategory(count, messageMask);
+                const size_t index = typeIndex(messageMask);
+                const int count = category_count_[index].fetch_add(1, std::memory_order_relaxed) + 1;
+                const int limit = category_limit_[index];
+                if (limit != NoLimit) {
+                    res = countBasedResponseCategory(count, limit);
                 }
             }
 
@@ -145,6 +196,60 @@ namespace Opm
         }
 
     private:
+        static const size_t num_message_types = 64;
+        static const size_t tag_table_size = 2048;
+
+        struct TagSlot
+        {
+            std::atomic<uint64_t> hash;
+            std::atomic<int> count;
+        };
+
+        /// Bit index of a power-of-2 message type.
+        static size_t typeIndex(int64_t messageType)
+        {
+            size_t index = 0;
+            uint64_t bits = uint64_t(messageType) >> 1;
+            while (bits) {
+                bits >>= 1;
+                index++;
+            }
+            return index;
+        }
+
+        /// 64 bit FNV-1a; never returns 0 since that marks an empty
+        /// table slot.
+        static uint64_t hashTag(const std::string& tag)
+        {
+            uint64_t hash = 14695981039346656037ULL;
+            for (char c : tag) {
+                hash ^= uint64_t(static_cast<unsigned char>(c));
+                hash *= 1099511628211ULL;
+            }
+            return hash ? hash : 1;
+        }
+
+        /// Linear probing; claims an empty slot with a CAS on the
+        /// first insertion of a tag, so concurrent first encounters
+        /// of the same tag agree on one slot. Returns NoTag if the
+        /// table is full - such tags are then not limited.
+        int findSlot(const uint64_t hash)
+        {
+            const size_t mask = tag_table_size - 1;
+            for (size_t probe = 0; probe < tag_table_size; ++probe) {
+                const size_t index = (hash + probe) & mask;
+                uint64_t slot_hash = tag_table_[index].hash.load(std::memory_order_acquire);
+                if (slot_hash == 0) {
+                    if (tag_table_[index].hash.compare_exchange_strong(slot_hash, hash, std::memory_order_acq_rel))
+                        return int(index);
+                    // slot_hash now holds the winning value.
+                }
+                if (slot_hash == hash)
+                    return int(index);
+            }
+            return NoTag;
+        }
+
         Response countBasedResponseTag(const int count) const
         {
             if (count <= tag_limit_) {
@@ -157,9 +262,8 @@ namespace Opm
         }
 
 
-        Response countBasedResponseCategory(const int count, const int64_t messageMask) const
+        Response countBasedResponseCategory(const int count, const int limit) const
         {
-            const int limit = category_limits_.at(messageMask);
             if (count <= limit) {
                 return Response::PrintMessage;
             } else if (count == limit + 1) {
@@ -170,14 +274,11 @@ namespace Opm
         }
 
         int tag_limit_;
-        std::unordered_map<std::string, int> tag_counts_;
         std::map<int64_t, int> category_limits_;
-        std::map<int64_t, int> category_counts_ = {{Log::MessageType::Note, 0},
-                                                   {Log::MessageType::Info, 0},
-                                                   {Log::MessageType::Warning, 0},
-                                                   {Log::MessageType::Error, 0},
-                                                   {Log::MessageType::Problem, 0},
-                                                   {Log::MessageType::Bug, 0}};
+        mutable std::map<int64_t, int> category_counts_view_;
+        std::array<int, num_message_types> category_limit_;
+        std::array<std::atomic<int>, num_message_types> category_count_;
+        std::unique_ptr<TagSlot[]> tag_table_;
     };
 
 
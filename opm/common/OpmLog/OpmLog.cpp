@@ -21,6 +21,7 @@
 #include <opm/common/OpmLog/Logger.hpp>
 #include <opm/common/OpmLog/StreamLog.hpp>
 #include <iostream>
+#include <mutex>
 #include <errno.h>  // For errno
 #include <stdio.h>  // For fileno() and stdout
 #include <unistd.h> // For isatty()
@@ -44,22 +45,33 @@ namespace Opm {
 
 
     std::shared_ptr<Logger> OpmLog::getLogger() {
-        if (!m_logger)
-            m_logger.reset( new Logger() );
-
-        return m_logger;
+        std::shared_ptr<Logger> logger = std::atomic_load( &m_logger );
+        if (!logger) {
+            /* The mutex only serializes the one-time creation; the
+               message functions never take it. */
+            static std::mutex creation_mutex;
+            std::lock_guard<std::mutex> lock( creation_mutex );
+            logger = std::atomic_load( &m_logger );
+            if (!logger) {
+                logger = std::make_shared<Logger>();
+                std::atomic_store( &m_logger , logger );
+            }
+        }
+        return logger;
     }
 
 
     void OpmLog::addMessage(int64_t messageFlag , const std::string& message) {
-        if (m_logger)
-            m_logger->addMessage( messageFlag , message );
+        auto logger = std::atomic_load( &m_logger );
+        if (logger)
+            logger->addMessage( messageFlag , message );
     }
 
 
     void OpmLog::addTaggedMessage(int64_t messageFlag, const std::string& tag, const std::string& message) {
-        if (m_logger)
-            m_logger->addTaggedMessage( messageFlag, tag, message );
+        auto logger = std::atomic_load( &m_logger );
+        if (logger)
+            logger->addTaggedMessage( messageFlag, tag, message );
     }
 
 
@@ -152,31 +164,35 @@ namespace Opm {
 
 
     bool OpmLog::enabledMessageType( int64_t messageType ) {
-        if (m_logger)
-            return m_logger->enabledMessageType( messageType );
+        auto logger = std::atomic_load( &m_logger );
+        if (logger)
+            return logger->enabledMessageType( messageType );
         else
             return Logger::enabledDefaultMessageType( messageType );
     }
 
     bool OpmLog::hasBackend(const std::string& name) {
-        if (m_logger)
-            return m_logger->hasBackend( name );
+        auto logger = std::atomic_load( &m_logger );
+        if (logger)
+            return logger->hasBackend( name );
         else
             return false;
     }
 
 
     bool OpmLog::removeBackend(const std::string& name) {
-        if (m_logger)
-            return m_logger->removeBackend( name );
+        auto logger = std::atomic_load( &m_logger );
+        if (logger)
+            return logger->removeBackend( name );
         else
             return false;
     }
 
 
     void OpmLog::removeAllBackends() {
-        if (m_logger) {
-            m_logger->removeAllBackends();
+        auto logger = std::atomic_load( &m_logger );
+        if (logger) {
+            logger->removeAllBackends();
         }
     }
 
@@ -33,6 +33,17 @@ namespace Opm {
 /*
   The OpmLog class is a fully static class which manages a proper
   Logger instance.
+
+  Thread safety: the logger singleton is created and accessed with
+  the std::atomic_load()/atomic_store() shared_ptr operations, so the
+  message functions can be called concurrently from many threads.
+  The backends themselves are only serialized when the logger is in
+  asynchronous mode - see Logger::setAsync() - where the calling
+  threads merely enqueue on a lock-free ring and a single background
+  thread performs formatting, limiting and I/O; that is the mode to
+  use when logging from threaded loops. Configuration (adding or
+  removing backends and message types) must not run concurrently
+  with messages.
 */
 
 
@@ -42,6 +53,25 @@ public:
     static void addMessage(int64_t messageFlag , const std::string& message);
     static void addTaggedMessage(int64_t messageFlag, const std::string& tag, const std::string& message);
 
+    /// Lazy overloads forwarding to the Logger overloads of the
+    /// same name: the callable producing the message text is only
+    /// invoked if the message will actually reach a backend. If no
+    /// logger has been created the message is discarded - like in
+    /// the eager overloads - without invoking the callable.
+    template <typename MessageBuilder, typename std::enable_if< !std::is_convertible<MessageBuilder, std::string>::value , int>::type = 0>
+    static void addMessage(int64_t messageFlag , MessageBuilder&& builder) {
+        auto logger = std::atomic_load( &m_logger );
+        if (logger)
+            logger->addMessage( messageFlag , std::forward<MessageBuilder>( builder ));
+    }
+
+    template <typename MessageBuilder, typename std::enable_if< !std::is_convertible<MessageBuilder, std::string>::value , int>::type = 0>
+    static void addTaggedMessage(int64_t messageFlag , const std::string& tag , MessageBuilder&& builder) {
+        auto logger = std::atomic_load( &m_logger );
+        if (logger)
+            logger->addTaggedMessage( messageFlag , tag , std::forward<MessageBuilder>( builder ));
+    }
+
     static void info(const std::string& message);
     static void warning(const std::string& message);
     static void error(const std::string& message);
@@ -58,6 +88,41 @@ public:
     static void debug(const std::string& tag, const std::string& message);
     static void note(const std::string& tag, const std::string& message);
 
+    template <typename MessageBuilder, typename std::enable_if< !std::is_convertible<MessageBuilder, std::string>::value , int>::type = 0>
+    static void info(MessageBuilder&& builder) {
+        OpmLog::addMessage( Log::MessageType::Info , std::forward<MessageBuilder>( builder ));
+    }
+
+    template <typename MessageBuilder, typename std::enable_if< !std::is_convertible<MessageBuilder, std::string>::value , int>::type = 0>
+    static void warning(MessageBuilder&& builder) {
+        OpmLog::addMessage( Log::MessageType::Warning , std::forward<MessageBuilder>( builder ));
+    }
+
+    template <typename MessageBuilder, typename std::enable_if< !std::is_convertible<MessageBuilder, std::string>::value , int>::type = 0>
+    static void error(MessageBuilder&& builder) {
+        OpmLog::addMessage( Log::MessageType::Error , std::forward<MessageBuilder>( builder ));
+    }
+
+    template <typename MessageBuilder, typename std::enable_if< !std::is_convertible<MessageBuilder, std::string>::value , int>::type = 0>
+    static void problem(MessageBuilder&& builder) {
+        OpmLog::addMessage( Log::MessageType::Problem , std::forward<MessageBuilder>( builder ));
+    }
+
+    template <typename MessageBuilder, typename std::enable_if< !std::is_convertible<MessageBuilder, std::string>::value , int>::type = 0>
+    static void bug(MessageBuilder&& builder) {
+        OpmLog::addMessage( Log::MessageType::Bug , std::forward<MessageBuilder>( builder ));
+    }
+
+    template <typename MessageBuilder, typename std::enable_if< !std::is_convertible<MessageBuilder, std::string>::value , int>::type = 0>
+    static void debug(MessageBuilder&& builder) {
+        OpmLog::addMessage( Log::MessageType::Debug , std::forward<MessageBuilder>( builder ));
+    }
+
+    template <typename MessageBuilder, typename std::enable_if< !std::is_convertible<MessageBuilder, std::string>::value , int>::type = 0>
+    static void note(MessageBuilder&& builder) {
+        OpmLog::addMessage( Log::MessageType::Note , std::forward<MessageBuilder>( builder ));
+    }
+
     static bool hasBackend( const std::string& backendName );
     static void addBackend(const std::string& name , std::shared_ptr<LogBackend> backend);
     static bool removeBackend(const std::string& name);
@@ -96,6 +161,55 @@ private:
 
 }
 
+/*
+  Compile-time message category elision.
+
+  The runtime mask in Logger filters messages cheaply, but the call
+  site still compiles in the construction of the message (or of the
+  lazy builder) and the call into the logging machinery. For
+  categories a build never wants - typically Debug and Note in
+  release builds - the OPM_LOG_* macros below remove the call site
+  entirely: they test the category against the compile-time constant
+  OPM_LOG_COMPILETIME_MESSAGE_TYPES, so for excluded categories the
+  whole statement is inside an if(false) over a constant condition
+  and is dropped by the compiler. The message argument is still type
+  checked, but never evaluated.
+
+  The mask defaults to all categories; a build can restrict it with
+  e.g.
+
+      -DOPM_LOG_COMPILETIME_MESSAGE_TYPES='(::Opm::Log::DefaultMessageTypes & ~(::Opm::Log::MessageType::Debug | ::Opm::Log::MessageType::Note))'
+
+  The macros accept the same message arguments as the OpmLog
+  functions they wrap - both eager strings and lazy builders - and
+  the runtime mask from enabledMessageType() still governs the
+  categories that remain compiled in.
+*/
+
+#ifndef OPM_LOG_COMPILETIME_MESSAGE_TYPES
+#define OPM_LOG_COMPILETIME_MESSAGE_TYPES ::Opm::Log::DefaultMessageTypes
+#endif
+
+#define OPM_LOG_MESSAGE(messageType, message)                           \
+    do {                                                                \
+        if ((messageType) & (OPM_LOG_COMPILETIME_MESSAGE_TYPES))        \
+            ::Opm::OpmLog::addMessage( (messageType) , message );       \
+    } while (false)
+
+#define OPM_LOG_TAGGED_MESSAGE(messageType, tag, message)               \
+    do {                                                                \
+        if ((messageType) & (OPM_LOG_COMPILETIME_MESSAGE_TYPES))        \
+            ::Opm::OpmLog::addTaggedMessage( (messageType) , tag , message ); \
+    } while (false)
+
+#define OPM_LOG_DEBUG(message)   OPM_LOG_MESSAGE(::Opm::Log::MessageType::Debug , message)
+#define OPM_LOG_NOTE(message)    OPM_LOG_MESSAGE(::Opm::Log::MessageType::Note , message)
+#define OPM_LOG_INFO(message)    OPM_LOG_MESSAGE(::Opm::Log::MessageType::Info , message)
+#define OPM_LOG_WARNING(message) OPM_LOG_MESSAGE(::Opm::Log::MessageType::Warning , message)
+#define OPM_LOG_ERROR(message)   OPM_LOG_MESSAGE(::Opm::Log::MessageType::Error , message)
+#define OPM_LOG_PROBLEM(message) OPM_LOG_MESSAGE(::Opm::Log::MessageType::Problem , message)
+#define OPM_LOG_BUG(message)     OPM_LOG_MESSAGE(::Opm::Log::MessageType::Bug , message)
+
 
 
 
@@ -16,19 +16,49 @@
   You should have received a copy of the GNU General Public License
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include <cstring>
+#include <iterator>
 #include <stdexcept>
+#include <vector>
+
+#include <zlib.h>
+
 #include <opm/common/OpmLog/StreamLog.hpp>
 
 namespace Opm {
 
+/*
+  The compressed output is one gzip stream written with
+  Z_SYNC_FLUSH at every flush point, so all complete frames can be
+  decompressed while the file is still growing; appending to an
+  existing compressed file starts a new gzip member, which the
+  reader - like zcat - handles transparently.
+*/
+struct StreamLog::Compressor {
+    z_stream stream;
+    std::vector<char> out;
+
+    Compressor() : out( 64 * 1024 )
+    {
+        std::memset( &stream , 0 , sizeof stream );
+        if (deflateInit2( &stream , Z_BEST_SPEED , Z_DEFLATED , 15 + 16 , 8 , Z_DEFAULT_STRATEGY ) != Z_OK)
+            throw std::runtime_error("Failed to initialize the log compressor");
+    }
+
+    ~Compressor() {
+        deflateEnd( &stream );
+    }
+};
+
 
-StreamLog::StreamLog(const std::string& logFile , int64_t messageMask, bool append) : LogBackend(messageMask)
+StreamLog::StreamLog(const std::string& logFile , int64_t messageMask, bool append, bool compress) : LogBackend(messageMask)
 {
-    if (append) {
-        m_ofstream.open( logFile.c_str() ,  std::ofstream::app );
-    } else {
-        m_ofstream.open( logFile.c_str() ,  std::ofstream::out );
+    std::ios_base::openmode mode = append ? std::ofstream::app : std::ofstream::out;
+    if (compress) {
+        mode |= std::ofstream::binary;
+        m_compressor.reset( new Compressor() );
     }
+    m_ofstream.open( logFile.c_str() , mode );
     m_streamOwner = true;
     m_ostream = &m_ofstream;
 }
@@ -42,18 +72,133 @@ StreamLog::StreamLog(std::ostream& os , int64_t messageMask) : LogBackend(messag
 
 
 void StreamLog::close() {
+    flush();
+    if (m_compressor && m_ostream) {
+        // Terminate the gzip stream.
+        z_stream& z = m_compressor->stream;
+        z.next_in = nullptr;
+        z.avail_in = 0;
+        int ret;
+        do {
+            z.next_out = reinterpret_cast<Bytef*>( m_compressor->out.data() );
+            z.avail_out = m_compressor->out.size();
+            ret = deflate( &z , Z_FINISH );
+            m_ostream->write( m_compressor->out.data() , m_compressor->out.size() - z.avail_out );
+        } while (ret != Z_STREAM_END);
+        m_ostream->flush();
+        m_compressor.reset();
+    }
     if (m_streamOwner && m_ofstream.is_open()) {
         m_ofstream.close();
         m_ostream = NULL;
     }
 }
 
+
+void StreamLog::writeOut(const char* data , size_t size , bool sync) {
+    if (!m_compressor) {
+        m_ostream->write( data , size );
+        if (sync)
+            m_ostream->flush();
+        return;
+    }
+
+    z_stream& z = m_compressor->stream;
+    z.next_in = reinterpret_cast<Bytef*>( const_cast<char*>( data ));
+    z.avail_in = size;
+    do {
+        z.next_out = reinterpret_cast<Bytef*>( m_compressor->out.data() );
+        z.avail_out = m_compressor->out.size();
+        deflate( &z , sync ? Z_SYNC_FLUSH : Z_NO_FLUSH );
+        m_ostream->write( m_compressor->out.data() , m_compressor->out.size() - z.avail_out );
+    } while (z.avail_in > 0 || (sync && z.avail_out == 0));
+    if (sync)
+        m_ostream->flush();
+}
+
+
+void StreamLog::setBuffering(size_t size_threshold, double flush_interval, int64_t flush_mask) {
+    flush();
+    m_buffered = true;
+    m_size_threshold = size_threshold;
+    m_flush_mask = flush_mask;
+    m_flush_interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::duration<double>( flush_interval ));
+    m_last_flush = std::chrono::steady_clock::now();
+    m_buffer.reserve( size_threshold );
+}
+
+
+void StreamLog::flush() {
+    if (!m_buffer.empty() && m_ostream) {
+        writeOut( m_buffer.data() , m_buffer.size() , true );
+        m_buffer.clear();
+    }
+    m_last_flush = std::chrono::steady_clock::now();
+}
+
+
 void StreamLog::addMessageUnconditionally(int64_t messageType, const std::string& message)
 {
-    (*m_ostream) << formatMessage(messageType, message) << std::endl;
-    if (m_ofstream.is_open()) {
-        m_ofstream.flush();
+    if (m_buffered) {
+        formatMessage(messageType, message, m_buffer);
+        m_buffer += '\n';
+
+        if ((messageType & m_flush_mask) ||
+            (m_buffer.size() >= m_size_threshold) ||
+            (std::chrono::steady_clock::now() - m_last_flush >= m_flush_interval))
+            flush();
+    } else {
+        std::string& buffer = formatBuffer();
+        formatMessage(messageType, message, buffer);
+        buffer += '\n';
+        writeOut( buffer.data() , buffer.size() , true );
+    }
+}
+
+
+std::string StreamLog::readCompressed(const std::string& logFile) {
+    std::ifstream stream( logFile.c_str() , std::ifstream::binary );
+    if (!stream)
+        throw std::runtime_error("Failed to open compressed log file: " + logFile);
+
+    std::string input( (std::istreambuf_iterator<char>( stream )) , std::istreambuf_iterator<char>() );
+    if (input.empty())
+        return "";
+
+    z_stream z;
+    std::memset( &z , 0 , sizeof z );
+    // 15 + 32: accept the gzip wrapper with automatic detection.
+    if (inflateInit2( &z , 15 + 32 ) != Z_OK)
+        throw std::runtime_error("Failed to initialize the log decompressor");
+
+    std::string text;
+    std::vector<char> out( 64 * 1024 );
+    z.next_in = reinterpret_cast<Bytef*>( &input[0] );
+    z.avail_in = input.size();
+    while (true) {
+        z.next_out = reinterpret_cast<Bytef*>( out.data() );
+        z.avail_out = out.size();
+        const int ret = inflate( &z , Z_NO_FLUSH );
+        text.append( out.data() , out.size() - z.avail_out );
+
+        if (ret == Z_STREAM_END) {
+            // An appended log starts a new gzip member.
+            if (z.avail_in == 0)
+                break;
+            inflateReset2( &z , 15 + 32 );
+        } else if (ret == Z_OK && (z.avail_in > 0 || z.avail_out == 0))
+            continue;
+        else if (ret == Z_OK || ret == Z_BUF_ERROR)
+            // All complete frames consumed; a torn frame at the
+            // tail of a live file ends here.
+            break;
+        else {
+            inflateEnd( &z );
+            throw std::runtime_error("The file: " + logFile + " is not a compressed log file");
+        }
     }
+    inflateEnd( &z );
+    return text;
 }
 
 
@@ -20,9 +20,12 @@
 #ifndef STREAMLOG_H
 #define STREAMLOG_H
 
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <cstdint>
+#include <memory>
+#include <string>
 
 #include <opm/common/OpmLog/LogBackend.hpp>
 
@@ -31,19 +34,63 @@ namespace Opm {
 class StreamLog : public LogBackend {
 
 public:
-    StreamLog(const std::string& logFile , int64_t messageMask, bool append = false);
+    /// When @compress is true the formatted output is streamed
+    /// through a gzip compressor before hitting the file - PRT style
+    /// text typically shrinks by an order of magnitude, which
+    /// matters when many ensemble members log to a shared
+    /// filesystem. Every flush point ends on a compressed frame
+    /// boundary, so the file can be followed while the run is live
+    /// with readCompressed() - or with zcat, which tolerates the
+    /// unterminated tail. Combine with setBuffering() so that one
+    /// frame covers many messages; an unbuffered compressed log
+    /// flushes a frame per message. The compressed stream is
+    /// properly terminated when the backend is destroyed.
+    StreamLog(const std::string& logFile , int64_t messageMask, bool append = false, bool compress = false);
     StreamLog(std::ostream& os , int64_t messageMask);
     ~StreamLog();
 
+    /// Decompress and return the current content of a log file
+    /// written with compress = true. The file may still be growing:
+    /// everything up to the last flush point is returned, and a
+    /// partially written frame at the tail is ignored.
+    static std::string readCompressed(const std::string& logFile);
+
+    /// Switch the backend to buffered output: formatted messages
+    /// accumulate in an internal buffer which goes to the stream in
+    /// one write when it exceeds size_threshold bytes, when more
+    /// than flush_interval seconds have passed since the last
+    /// write, or when a message matches flush_mask - by default the
+    /// Error and Bug categories, so crash-relevant messages remain
+    /// durable. An unbuffered StreamLog writes and flushes every
+    /// message separately, which can dominate the cost of a chatty
+    /// log on a network filesystem.
+    void setBuffering(size_t size_threshold,
+                      double flush_interval = 1.0,
+                      int64_t flush_mask = Log::MessageType::Error | Log::MessageType::Bug);
+
+    /// Write out the internal buffer - a no-op unless buffering has
+    /// been enabled with setBuffering().
+    void flush() override;
+
 protected:
     virtual void addMessageUnconditionally(int64_t messageType, const std::string& message) override;
 
 private:
+    struct Compressor;
+
     void close();
+    void writeOut(const char* data , size_t size , bool sync);
 
+    std::unique_ptr<Compressor> m_compressor;
     std::ofstream   m_ofstream;
     std::ostream  * m_ostream;
     bool m_streamOwner;
+    bool m_buffered = false;
+    std::string m_buffer;
+    size_t m_size_threshold = 0;
+    int64_t m_flush_mask = 0;
+    std::chrono::steady_clock::duration m_flush_interval = std::chrono::steady_clock::duration::zero();
+    std::chrono::steady_clock::time_point m_last_flush;
 };
 }
 
@@ -16,6 +16,7 @@
   You should have received a copy of the GNU General Public License
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <algorithm>
 #include <stdexcept>
 #include <cassert>
 #include <iomanip>
@@ -40,18 +41,68 @@ TimerLog::TimerLog(std::ostream& os) : StreamLog( os , StopTimer | StartTimer )
 }
 
 
+void TimerLog::startRegion(const std::string& /* name */) {
+    m_active.push_back( std::chrono::steady_clock::now() );
+}
 
-void TimerLog::addMessageUnconditionally(int64_t messageType, const std::string& msg ) {
-    if (messageType == StopTimer) {
-        clock_t stop = clock();
-        double secondsElapsed = 1.0 * (m_start - stop) / CLOCKS_PER_SEC ;
 
-        m_work.str("");
-        m_work << std::fixed << msg << ": " << secondsElapsed << " seconds ";
-        StreamLog::addMessageUnconditionally( messageType, m_work.str());
+void TimerLog::stopRegion(const std::string& name) {
+    if (m_active.empty())
+        throw std::logic_error("Tried to stop timer region: " + name + " with no region active");
+
+    const auto stop = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>( stop - m_active.back() ).count();
+    m_active.pop_back();
+
+    RegionStats& stats = m_stats[ name ];
+    if (stats.count == 0) {
+        stats.min = seconds;
+        stats.max = seconds;
     } else {
+        stats.min = std::min( stats.min , seconds );
+        stats.max = std::max( stats.max , seconds );
+    }
+    stats.count++;
+    stats.total += seconds;
+
+    m_work.str("");
+    m_work << std::fixed << name << ": " << seconds << " seconds ";
+    StreamLog::addMessageUnconditionally( StopTimer, m_work.str());
+}
+
+
+const std::map<std::string, TimerLog::RegionStats>& TimerLog::regionStats() const {
+    return m_stats;
+}
+
+
+void TimerLog::summary() {
+    for (const auto& pair : m_stats) {
+        const RegionStats& stats = pair.second;
+        m_work.str("");
+        m_work << std::fixed << pair.first << ": "
+               << stats.count << " calls "
+               << stats.total << " seconds total "
+               << stats.min << " min "
+               << stats.max << " max "
+               << stats.total / stats.count << " avg";
+        StreamLog::addMessageUnconditionally( StopTimer, m_work.str());
+    }
+}
+
+
+void TimerLog::clear() {
+    m_active.clear();
+    m_stats.clear();
+}
+
+
+void TimerLog::addMessageUnconditionally(int64_t messageType, const std::string& msg ) {
+    if (messageType == StopTimer)
+        stopRegion( msg );
+    else {
         if (messageType == StartTimer)
-            m_start = clock();
+            startRegion( msg );
     }
 }
 
@@ -19,17 +19,35 @@
 #ifndef OPM_TIMERLOG_HPP
 #define OPM_TIMERLOG_HPP
 
-#include <time.h>
-
+#include <chrono>
+#include <map>
 #include <memory>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <opm/common/OpmLog/StreamLog.hpp>
 
 /*
-  This class is a simple demonstration of how the logging framework
-  can be used to create a simple very special case logging facility. 
+  The TimerLog backend times named regions of the simulation on
+  std::chrono::steady_clock - wall time, so the numbers stay
+  meaningful in threaded runs where the old clock() would sum the
+  CPU time of every thread. Regions nest: starts and stops form a
+  LIFO stack, so a region can be timed inside another, and each
+  completed region is logged and folded into per-name statistics
+  (count, total, min, max) which summary() reports on demand.
+
+  Regions can be driven in two ways: through the normal message
+  interface with the StartTimer/StopTimer message types - where the
+  region name is the message passed with StopTimer - or directly
+  with the RAII TimerLog::Scope helper:
+
+      TimerLog::Scope scope( *timer , "assembly" );
+
+  When the TimerLog mask is disabled in the Logger the Start/Stop
+  messages are dropped before they reach the backend, so leaving the
+  instrumentation in costs one masked integer test per message.
 */
 
 namespace Opm {
@@ -39,9 +57,63 @@ public:
     static const int64_t StartTimer = 4096;
     static const int64_t StopTimer  = 8192;
 
+    /// Aggregated wall times (in seconds) for one region name.
+    struct RegionStats {
+        size_t count = 0;
+        double total = 0;
+        double min = 0;
+        double max = 0;
+    };
+
+    /// RAII helper timing the enclosing scope as the region @name.
+    class Scope {
+    public:
+        Scope(TimerLog& timer, const std::string& name) :
+            m_timer( timer ),
+            m_name( name )
+        {
+            m_timer.startRegion( m_name );
+        }
+
+        ~Scope() {
+            /* If clear() has dropped the active regions while this
+               Scope was live, stopRegion() throws - a profiling
+               helper must never escalate that to std::terminate
+               from a noexcept destructor, so the stop is simply
+               skipped. */
+            try {
+                m_timer.stopRegion( m_name );
+            } catch (const std::logic_error&) {
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        TimerLog& m_timer;
+        std::string m_name;
+    };
+
     TimerLog(const std::string& logFile);
     TimerLog(std::ostream& os);
 
+    /// Push a new region start on the stack.
+    void startRegion(const std::string& name);
+
+    /// Stop the most recently started region, log the elapsed time
+    /// as "name: elapsed seconds" and fold it into the statistics
+    /// for @name. Throws std::logic_error if no region is active.
+    void stopRegion(const std::string& name);
+
+    /// The aggregated statistics for the completed regions.
+    const std::map<std::string, RegionStats>& regionStats() const;
+
+    /// Log a report with count, total, min, max and average wall
+    /// time for every region name seen so far.
+    void summary();
+
+    /// Drop all statistics and any active regions.
     void clear();
     ~TimerLog() {};
 
@@ -49,7 +121,8 @@ protected:
     void addMessageUnconditionally(int64_t messageFlag,
                                    const std::string& message) override;
 private:
-    clock_t m_start;
+    std::vector<std::chrono::steady_clock::time_point> m_active;
+    std::map<std::string, RegionStats> m_stats;
     std::ostringstream m_work;
 };
 
@@ -58,4 +131,3 @@ typedef std::shared_ptr<const TimerLog> TimerLogConstPtr;
 } // namespace Opm
 
 #endif
-
@@ -17,17 +17,152 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/common/util/numeric/cmp.hpp>
 #include <opm/common/data/SimulationDataContainer.hpp>
 
 namespace Opm {
 
+    namespace {
+        // Alignment of the field offsets in the contiguous arena,
+        // in units of double elements; 8 doubles = 64 bytes = one
+        // cache line.
+        const size_t arena_alignment = 8;
+
+        // Fields smaller than this are always filled serially; the
+        // thread start overhead dominates below it.
+        const size_t parallel_fill_threshold = 65536;
+
+        std::shared_ptr<double> allocateAligned( size_t capacity ) {
+            void* ptr = nullptr;
+            if (posix_memalign( &ptr , 64 , capacity * sizeof(double) ))
+                throw std::bad_alloc();
+            return std::shared_ptr<double>( static_cast<double*>(ptr) , free );
+        }
+
+        // Magic marker and page size of the binary checkpoint format;
+        // the data section starts on a page boundary so that load()
+        // can expose it directly from the mmap()ed file.
+        const char checkpoint_magic[8] = { 'O','P','M','S','D','C','0','1' };
+        const size_t checkpoint_page = 4096;
+
+        void writeU64( std::ostream& stream , uint64_t value ) {
+            stream.write( reinterpret_cast<const char*>( &value ) , sizeof value );
+        }
+
+        uint64_t readU64( const char*& cursor ) {
+            uint64_t value;
+            std::memcpy( &value , cursor , sizeof value );
+            cursor += sizeof value;
+            return value;
+        }
+
+        // Fast non-cryptographic 64 bit hash processing one 8 byte
+        // word per iteration, in the style of (and with the prime
+        // constants of) xxHash64; throughput is limited by memory
+        // bandwidth for the field sizes we care about.
+        const uint64_t hash_prime1 = 11400714785074694791ULL;
+        const uint64_t hash_prime2 = 14029467366897019727ULL;
+        const uint64_t hash_prime3 = 1609587929392839161ULL;
+
+        uint64_t rotl64( uint64_t value , int shift ) {
+            return (value << shift) | (value >> (64 - shift));
+        }
+
+        uint64_t hashBytes( const void* ptr , size_t num_bytes ) {
+            const char* data = static_cast<const char*>( ptr );
+            uint64_t h = hash_prime3 ^ num_bytes;
+
+            for (size_t i = 0; i + 8 <= num_bytes; i += 8) {
+                uint64_t word;
+                std::memcpy( &word , data + i , 8 );
+                h = rotl64( h ^ (word * hash_prime2) , 31 ) * hash_prime1;
+            }
+            if (num_bytes % 8) {
+                uint64_t word = 0;
+                std::memcpy( &word , data + num_bytes - (num_bytes % 8) , num_bytes % 8 );
+                h = rotl64( h ^ (word * hash_prime2) , 31 ) * hash_prime1;
+            }
+
+            h ^= h >> 33;
+            h *= hash_prime2;
+            h ^= h >> 29;
+            h *= hash_prime3;
+            h ^= h >> 32;
+            return h;
+        }
+
+        uint64_t hashCombine( uint64_t seed , uint64_t value ) {
+            return seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2));
+        }
+
+        void parallelFill( double* data , size_t size , double value , int num_threads ) {
+            if (num_threads < 2 || size < parallel_fill_threshold) {
+                std::fill( data , data + size , value );
+                return;
+            }
+
+            // Static partition of the index range; thread t touches
+            // the same pages a static OpenMP loop over the cells
+            // would assign to thread t.
+            std::vector<std::thread> team;
+            const size_t chunk = size / num_threads;
+            for (int t = 0; t < num_threads; t++) {
+                size_t begin = t * chunk;
+                size_t end = (t == num_threads - 1) ? size : begin + chunk;
+                team.emplace_back( [data, begin, end, value] {
+                        std::fill( data + begin , data + end , value );
+                    });
+            }
+            for (auto& thread : team)
+                thread.join();
+        }
+    }
+
+    int SimulationDataContainer::s_initialization_threads = 1;
+
+    void SimulationDataContainer::setInitializationThreads(int num_threads) {
+        s_initialization_threads = (num_threads < 1) ? 1 : num_threads;
+    }
+
+    int SimulationDataContainer::initializationThreads() {
+        return s_initialization_threads;
+    }
+
+
     SimulationDataContainer::SimulationDataContainer(size_t num_cells, size_t num_faces , size_t num_phases) :
+        SimulationDataContainer( num_cells , num_faces , num_phases , Storage::Individual )
+    {
+    }
+
+    SimulationDataContainer::SimulationDataContainer(size_t num_cells, size_t num_faces , size_t num_phases, Storage storage) :
         m_num_cells( num_cells ),
         m_num_faces( num_faces ),
-        m_num_phases( num_phases )
+        m_num_phases( num_phases ),
+        m_storage( storage )
     {
+        if (m_storage == Storage::Contiguous) {
+            // Reserve room for the default fields plus a handful of
+            // user fields, so that the common case never reallocates;
+            // the reserved pages are not touched until a field is
+            // registered in them.
+            m_cell_arena_capacity = (m_num_phases + 6) * (m_num_cells + arena_alignment);
+            m_cell_arena = allocateAligned( m_cell_arena_capacity );
+        }
         addDefaultFields( );
     }
 
@@ -35,10 +170,23 @@ namespace Opm {
         : m_num_cells(other.m_num_cells),
           m_num_faces(other.m_num_faces),
           m_num_phases(other.m_num_phases),
-          m_cell_data(other.m_cell_data),
-          m_face_data(other.m_face_data)
+          m_storage(other.m_storage),
+          m_cell_field_names(other.m_cell_field_names),
+          m_cell_meta(other.m_cell_meta),
+          m_face_field_names(other.m_face_field_names),
+          m_face_meta(other.m_face_meta),
+          m_cell_arena(other.m_cell_arena),
+          m_cell_arena_size(other.m_cell_arena_size),
+          m_cell_arena_capacity(other.m_cell_arena_capacity),
+          pressure_handle_(other.pressure_handle_),
+          temperature_handle_(other.temperature_handle_),
+          saturation_handle_(other.saturation_handle_),
+          facepressure_handle_(other.facepressure_handle_),
+          faceflux_handle_(other.faceflux_handle_)
     {
-        setReferencePointers();
+        // The meta copies share the field buffers with @other; the
+        // buffers are detached field by field when first accessed
+        // mutably.
     }
 
     SimulationDataContainer& SimulationDataContainer::operator=(const SimulationDataContainer& other)
@@ -55,10 +203,46 @@ namespace Opm {
         swap(m_num_cells, other.m_num_cells);
         swap(m_num_faces, other.m_num_faces);
         swap(m_num_phases, other.m_num_phases);
-        swap(m_cell_data, other.m_cell_data);
-        swap(m_face_data, other.m_face_data);
-        setReferencePointers();
-        other.setReferencePointers();
+        swap(m_storage, other.m_storage);
+        swap(m_cell_field_names, other.m_cell_field_names);
+        swap(m_cell_meta, other.m_cell_meta);
+        swap(m_face_field_names, other.m_face_field_names);
+        swap(m_face_meta, other.m_face_meta);
+        swap(m_cell_arena, other.m_cell_arena);
+        swap(m_cell_arena_size, other.m_cell_arena_size);
+        swap(m_cell_arena_capacity, other.m_cell_arena_capacity);
+        swap(pressure_handle_, other.pressure_handle_);
+        swap(temperature_handle_, other.temperature_handle_);
+        swap(saturation_handle_, other.saturation_handle_);
+        swap(facepressure_handle_, other.facepressure_handle_);
+        swap(faceflux_handle_, other.faceflux_handle_);
+    }
+
+
+    void SimulationDataContainer::detachCellField( FieldHandle handle ) {
+        FieldMeta& meta = m_cell_meta[ handle ];
+        if (meta.fdata)
+            meta.fdata = std::make_shared<std::vector<float>>( *meta.fdata );
+        else
+            meta.data = std::make_shared<std::vector<double>>( *meta.data );
+    }
+
+    void SimulationDataContainer::detachFaceField( FieldHandle handle ) {
+        FieldMeta& meta = m_face_meta[ handle ];
+        meta.data = std::make_shared<std::vector<double>>( *meta.data );
+    }
+
+    void SimulationDataContainer::detachCellArena() {
+        auto arena = allocateAligned( m_cell_arena_capacity );
+        std::copy( m_cell_arena.get() , m_cell_arena.get() + m_cell_arena_size , arena.get() );
+        m_cell_arena = arena;
+    }
+
+    void SimulationDataContainer::growCellArena( size_t capacity ) {
+        auto arena = allocateAligned( capacity );
+        std::copy( m_cell_arena.get() , m_cell_arena.get() + m_cell_arena_size , arena.get() );
+        m_cell_arena = arena;
+        m_cell_arena_capacity = capacity;
     }
 
 
@@ -75,34 +259,123 @@ namespace Opm {
         return m_num_cells;
     }
 
+    SimulationDataContainer::Storage SimulationDataContainer::storage() const {
+        return m_storage;
+    }
+
 
     bool SimulationDataContainer::hasCellData( const std::string& name ) const {
-        return ( m_cell_data.find( name ) == m_cell_data.end() ? false : true );
+        for (const auto& field_name : m_cell_field_names) {
+            if (field_name == name)
+                return true;
+        }
+        return false;
     }
 
 
     std::vector<double>& SimulationDataContainer::getCellData( const std::string& name ) {
-        auto iter = m_cell_data.find( name );
-        if (iter == m_cell_data.end()) {
-            throw std::invalid_argument("The cell data with name: " + name + " does not exist");
-        } else
-            return iter->second;
+        return getCellData( getCellDataHandle( name ));
     }
 
 
     const std::vector<double>& SimulationDataContainer::getCellData( const std::string& name ) const {
-        auto iter = m_cell_data.find( name );
-        if (iter == m_cell_data.end()) {
-            throw std::invalid_argument("The cell data with name: " + name + " does not exist");
-        } else
-            return iter->second;
+        return getCellData( getCellDataHandle( name ));
+    }
+
+
+    SimulationDataContainer::FieldView SimulationDataContainer::cellDataView( const std::string& name ) {
+        return cellDataView( getCellDataHandle( name ));
+    }
+
+    SimulationDataContainer::ConstFieldView SimulationDataContainer::cellDataView( const std::string& name ) const {
+        return cellDataView( getCellDataHandle( name ));
+    }
+
+
+    size_t SimulationDataContainer::allocateCellArena( size_t size ) {
+        size_t offset = m_cell_arena_size;
+        if (offset % arena_alignment)
+            offset += arena_alignment - (offset % arena_alignment);
+
+        if (offset + size > m_cell_arena_capacity)
+            growCellArena( std::max( 2 * m_cell_arena_capacity , offset + size ));
+
+        m_cell_arena_size = offset + size;
+        return offset;
+    }
+
+
+    SimulationDataContainer::FieldHandle SimulationDataContainer::registerCellData( const std::string& name , size_t components , double initialValue) {
+        return registerCellData( name , components , Layout::CellMajor , initialValue );
+    }
+
+
+    SimulationDataContainer::FieldHandle SimulationDataContainer::registerCellData( const std::string& name , size_t components , Layout layout , double initialValue) {
+        if (!hasCellData( name )) {
+            size_t size = components * m_num_cells;
+            FieldMeta meta{ components , size , 0 , layout , nullptr , nullptr , 1 , 0 , 0 , 0 };
+
+            if (m_storage == Storage::Contiguous) {
+                if (!m_cell_arena.unique())
+                    detachCellArena();
+                meta.offset = allocateCellArena( size );
+                parallelFill( m_cell_arena.get() + meta.offset , size , initialValue , s_initialization_threads );
+            } else if (s_initialization_threads < 2) {
+                meta.data = std::make_shared<std::vector<double>>( size , initialValue );
+            } else {
+                meta.data = std::make_shared<std::vector<double>>( size );
+                parallelFill( meta.data->data() , size , initialValue , s_initialization_threads );
+            }
+            m_cell_field_names.push_back( name );
+            m_cell_meta.push_back( meta );
+        }
+        return getCellDataHandle( name );
+    }
+
+
+    SimulationDataContainer::FieldHandle SimulationDataContainer::registerCellData( const std::string& name , size_t components , std::vector<double>&& data , Layout layout) {
+        if (!hasCellData( name )) {
+            size_t size = components * m_num_cells;
+            if (data.size() != size)
+                OPM_THROW(std::invalid_argument , "Wrong size of adopted data vector for: " << name << " expected: " << size << " got: " << data.size());
+
+            FieldMeta meta{ components , size , 0 , layout , nullptr , nullptr , 1 , 0 , 0 , 0 };
+            if (m_storage == Storage::Contiguous) {
+                if (!m_cell_arena.unique())
+                    detachCellArena();
+                meta.offset = allocateCellArena( size );
+                std::copy( data.begin() , data.end() , m_cell_arena.get() + meta.offset );
+            } else {
+                meta.data = std::make_shared<std::vector<double>>( std::move( data ));
+            }
+            m_cell_field_names.push_back( name );
+            m_cell_meta.push_back( meta );
+        }
+        return getCellDataHandle( name );
     }
 
 
-    void SimulationDataContainer::registerCellData( const std::string& name , size_t components , double initialValue) {
+    SimulationDataContainer::FieldHandle SimulationDataContainer::registerCellData( const std::string& name , size_t components , Precision precision , double initialValue) {
+        if (precision == Precision::Double)
+            return registerCellData( name , components , initialValue );
+
         if (!hasCellData( name )) {
-            m_cell_data.insert( std::pair<std::string , std::vector<double>>( name , std::vector<double>(components * m_num_cells , initialValue )));
+            size_t size = components * m_num_cells;
+            FieldMeta meta{ components , size , 0 , Layout::CellMajor , nullptr ,
+                            std::make_shared<std::vector<float>>( size , float( initialValue )) , 1 , 0 , 0 , 0 };
+            m_cell_field_names.push_back( name );
+            m_cell_meta.push_back( meta );
         }
+        return getCellDataHandle( name );
+    }
+
+
+    SimulationDataContainer::FieldHandle SimulationDataContainer::getCellDataHandle( const std::string& name ) const {
+        for (size_t handle = 0; handle < m_cell_field_names.size(); handle++) {
+            if (m_cell_field_names[handle] == name)
+                return handle;
+        }
+        throw std::invalid_argument("The cell data with name: " + name + " does not exist");
     }
 
 
@@ -110,137 +383,765 @@ namespace Opm {
                                                         size_t component ,
                                                         const std::vector<int>& cells ,
                                                         const std::vector<double>& values) {
-        auto& data = getCellData( key );
-        if (component >= m_num_phases)
-            OPM_THROW(std::invalid_argument, "The component number: " << component << " is invalid");
-
-
         if (cells.size() != values.size())
             OPM_THROW(std::invalid_argument, "size mismatch between cells and values");
 
-        // This is currently quite broken; the setCellDataComponent
-        // method assumes that the number of components in the field
-        // we are currently focusing on has num_phases components in
-        // total. This restriction should be lifted by allowing a per
-        // field number of components.
+        applyCellDataUpdates( { ComponentUpdate{ getCellDataHandle( key ) , component ,
+                                                 cells.data() , 0 , values.data() , cells.size() } } );
+    }
+
+
+    void SimulationDataContainer::applyCellDataUpdates( const std::vector<ComponentUpdate>& updates ) {
+        // Validate the complete batch up front, so that a throwing
+        // call leaves the container untouched and the scatter loops
+        // below can run without per element checks.
+        for (const auto& update : updates) {
+            if (update.field >= m_cell_meta.size())
+                OPM_THROW(std::invalid_argument, "The field handle: " << update.field << " is invalid");
 
-        if (data.size() != m_num_phases * m_num_cells)
-            OPM_THROW(std::invalid_argument , "Can currently only be used on fields with num_components == num_phases (i.e. saturation...) ");
+            const FieldMeta& meta = m_cell_meta[ update.field ];
+            if (meta.fdata)
+                OPM_THROW(std::invalid_argument, "Batched updates of float precision fields are not supported");
+            if (update.component >= meta.components)
+                OPM_THROW(std::invalid_argument, "The component number: " << update.component << " is invalid");
+
+            if (update.cells) {
+                for (size_t i = 0; i < update.count; i++) {
+                    if (size_t(update.cells[i]) >= m_num_cells)
+                        OPM_THROW(std::invalid_argument , "The cell number: " << update.cells[i] << " is invalid.");
+                }
+            } else if (update.first_cell + update.count > m_num_cells)
+                OPM_THROW(std::invalid_argument , "The cell range: [" << update.first_cell << "," << update.first_cell + update.count << ") is invalid.");
+        }
 
+        for (const auto& update : updates) {
+            auto data = cellDataComponent( update.field , update.component );
+            const double* values = update.values;
 
-        for (size_t i = 0; i < cells.size(); i++) {
-            if (size_t(cells[i]) < m_num_cells) {
-                auto field_index = cells[i] * m_num_phases + component;
-                data[field_index] = values[i];
+            if (update.cells) {
+                // Branch free scatter over the index list; with unit
+                // stride the compiler can vectorize this directly.
+                double* base = data.data;
+                const size_t stride = data.stride;
+                const int* cells = update.cells;
+                for (size_t i = 0; i < update.count; i++)
+                    base[ cells[i] * stride ] = values[i];
+            } else if (data.stride == 1) {
+                std::copy( values , values + update.count , data.data + update.first_cell );
             } else {
-                OPM_THROW(std::invalid_argument , "The cell number: " << cells[i] << " is invalid.");
+                for (size_t i = 0; i < update.count; i++)
+                    data[ update.first_cell + i ] = values[i];
             }
         }
     }
 
 
+    SimulationDataContainer::ComponentView SimulationDataContainer::cellDataComponent( const std::string& name , size_t component ) {
+        return cellDataComponent( getCellDataHandle( name ) , component );
+    }
+
+    SimulationDataContainer::ConstComponentView SimulationDataContainer::cellDataComponent( const std::string& name , size_t component ) const {
+        return cellDataComponent( getCellDataHandle( name ) , component );
+    }
+
+    SimulationDataContainer::ComponentView SimulationDataContainer::cellDataComponent( FieldHandle handle , size_t component ) {
+        const FieldMeta& meta = m_cell_meta[ handle ];
+        if (component >= meta.components)
+            OPM_THROW(std::invalid_argument, "The component number: " << component << " is invalid");
+
+        auto field = cellDataView( handle );
+        if (meta.layout == Layout::ComponentMajor)
+            return ComponentView{ field.data + component * m_num_cells , 1 , m_num_cells };
+        else
+            return ComponentView{ field.data + component , meta.components , m_num_cells };
+    }
+
+    SimulationDataContainer::ConstComponentView SimulationDataContainer::cellDataComponent( FieldHandle handle , size_t component ) const {
+        const FieldMeta& meta = m_cell_meta[ handle ];
+        if (component >= meta.components)
+            OPM_THROW(std::invalid_argument, "The component number: " << component << " is invalid");
+
+        auto field = cellDataView( handle );
+        if (meta.layout == Layout::ComponentMajor)
+            return ConstComponentView{ field.data + component * m_num_cells , 1 , m_num_cells };
+        else
+            return ConstComponentView{ field.data + component , meta.components , m_num_cells };
+    }
+
+
+    SimulationDataContainer::Layout SimulationDataContainer::cellDataLayout( const std::string& name ) const {
+        return cellDataLayout( getCellDataHandle( name ));
+    }
+
+    SimulationDataContainer::Layout SimulationDataContainer::cellDataLayout( FieldHandle handle ) const {
+        return m_cell_meta[ handle ].layout;
+    }
+
+
+    SimulationDataContainer::Precision SimulationDataContainer::cellDataPrecision( const std::string& name ) const {
+        return cellDataPrecision( getCellDataHandle( name ));
+    }
+
+    SimulationDataContainer::Precision SimulationDataContainer::cellDataPrecision( FieldHandle handle ) const {
+        return m_cell_meta[ handle ].fdata ? Precision::Float : Precision::Double;
+    }
+
+
+    std::vector<float>& SimulationDataContainer::getCellDataFloat( const std::string& name ) {
+        return getCellDataFloat( getCellDataHandle( name ));
+    }
+
+    const std::vector<float>& SimulationDataContainer::getCellDataFloat( const std::string& name ) const {
+        return getCellDataFloat( getCellDataHandle( name ));
+    }
+
+
+    std::vector<double> SimulationDataContainer::cellDataAsDouble( const std::string& name ) const {
+        return cellDataAsDouble( getCellDataHandle( name ));
+    }
+
+    std::vector<double> SimulationDataContainer::cellDataAsDouble( FieldHandle handle ) const {
+        const FieldMeta& meta = m_cell_meta[ handle ];
+        if (meta.fdata)
+            return std::vector<double>( meta.fdata->begin() , meta.fdata->end() );
+
+        const auto view = cellDataView( handle );
+        return std::vector<double>( view.begin() , view.end() );
+    }
+
+
+    void SimulationDataContainer::convertCellDataLayout( const std::string& name , Layout layout ) {
+        convertCellDataLayout( getCellDataHandle( name ) , layout );
+    }
+
+    void SimulationDataContainer::convertCellDataLayout( FieldHandle handle , Layout layout ) {
+        FieldMeta& meta = m_cell_meta[ handle ];
+        if (meta.layout == layout)
+            return;
+
+        auto field = cellDataView( handle );
+        std::vector<double> work( field.begin() , field.end() );
+        if (layout == Layout::ComponentMajor) {
+            for (size_t cell = 0; cell < m_num_cells; cell++)
+                for (size_t component = 0; component < meta.components; component++)
+                    field.data[ component * m_num_cells + cell ] = work[ cell * meta.components + component ];
+        } else {
+            for (size_t cell = 0; cell < m_num_cells; cell++)
+                for (size_t component = 0; component < meta.components; component++)
+                    field.data[ cell * meta.components + component ] = work[ component * m_num_cells + cell ];
+        }
+        meta.layout = layout;
+    }
+
+
     bool SimulationDataContainer::hasFaceData( const std::string& name ) const {
-        return ( m_face_data.find( name ) == m_face_data.end() ? false : true );
+        for (const auto& field_name : m_face_field_names) {
+            if (field_name == name)
+                return true;
+        }
+        return false;
     }
 
 
     std::vector<double>& SimulationDataContainer::getFaceData( const std::string& name ) {
-        auto iter = m_face_data.find( name );
-        if (iter == m_face_data.end()) {
-            throw std::invalid_argument("The face data with name: " + name + " does not exist");
-        } else
-            return iter->second;
+        return getFaceData( getFaceDataHandle( name ));
     }
 
     const std::vector<double>& SimulationDataContainer::getFaceData( const std::string& name ) const {
-        auto iter = m_face_data.find( name );
-        if (iter == m_face_data.end()) {
-            throw std::invalid_argument("The Face data with name: " + name + " does not exist");
-        } else
-            return iter->second;
+        return getFaceData( getFaceDataHandle( name ));
     }
 
 
-    void SimulationDataContainer::registerFaceData( const std::string& name , size_t components , double initialValue) {
+    SimulationDataContainer::FieldHandle SimulationDataContainer::registerFaceData( const std::string& name , size_t components , double initialValue) {
         if (!hasFaceData( name )) {
-            m_face_data.insert( std::pair<std::string , std::vector<double>>( name , std::vector<double>(components * m_num_faces , initialValue )));
+            size_t size = components * m_num_faces;
+            m_face_field_names.push_back( name );
+            m_face_meta.push_back( FieldMeta{ components , size , 0 , Layout::CellMajor ,
+                                              std::make_shared<std::vector<double>>( size , initialValue ) , nullptr , 1 , 0 , 0 , 0 } );
+        }
+        return getFaceDataHandle( name );
+    }
+
+
+    SimulationDataContainer::FieldHandle SimulationDataContainer::getFaceDataHandle( const std::string& name ) const {
+        for (size_t handle = 0; handle < m_face_field_names.size(); handle++) {
+            if (m_face_field_names[handle] == name)
+                return handle;
         }
+        throw std::invalid_argument("The face data with name: " + name + " does not exist");
     }
 
     bool SimulationDataContainer::equal( const SimulationDataContainer& other ) const {
+        return equal( other , 1 );
+    }
+
+    bool SimulationDataContainer::equal( const SimulationDataContainer& other , int num_threads ) const {
         if ((m_num_cells != other.m_num_cells) ||
             (m_num_phases != other.m_num_phases) ||
             (m_num_faces != other.m_num_faces))
             return false;
 
-        if ((m_face_data.size() != other.m_face_data.size()) ||
-            (m_cell_data.size() != other.m_cell_data.size()))
+        if ((m_face_field_names.size() != other.m_face_field_names.size()) ||
+            (m_cell_field_names.size() != other.m_cell_field_names.size()))
             return false;
 
-        for (const auto& cell_data : m_cell_data) {
-            const auto key = cell_data.first;
-            const auto data = cell_data.second;
+        // First pass: compare the structure - field names, precision
+        // and sizes - and collect the raw array pairs which must be
+        // compared element wise. The comparison goes through the
+        // views so that containers with different storage modes can
+        // be compared.
+        struct CompareTask {
+            const double* data;
+            const double* other_data;
+            const float* fdata;
+            const float* other_fdata;
+            size_t size;
+        };
+        std::vector<CompareTask> tasks;
+        size_t total_elements = 0;
+
+        for (const auto& key : m_cell_field_names) {
+            if (!other.hasCellData( key ))
+                return false;
+
+            const FieldHandle handle = getCellDataHandle( key );
+            const FieldHandle other_handle = other.getCellDataHandle( key );
+            if (cellDataPrecision( handle ) != other.cellDataPrecision( other_handle ))
+                return false;
+
+            // The element wise pass below compares the raw arrays,
+            // which is only meaningful when multi component fields
+            // agree on the component layout; a layout mismatch is a
+            // structural difference. Single component fields store
+            // identically in both layouts.
+            if ((m_cell_meta[ handle ].components > 1) &&
+                (m_cell_meta[ handle ].layout != other.m_cell_meta[ other_handle ].layout))
+                return false;
+
+            if (m_cell_meta[ handle ].components != other.m_cell_meta[ other_handle ].components)
+                return false;
 
-            if (other.hasCellData( key )) {
-                const auto& other_data = other.getCellData( key );
-                if (!cmp::vector_equal<double>( data , other_data ))
+            if (cellDataPrecision( handle ) == Precision::Float) {
+                const auto& data = getCellDataFloat( handle );
+                const auto& other_data = other.getCellDataFloat( other_handle );
+                if (data.size() != other_data.size())
                     return false;
-            } else
+                tasks.push_back( CompareTask{ nullptr , nullptr , data.data() , other_data.data() , data.size() } );
+            } else {
+                const auto data = cellDataView( handle );
+                const auto other_data = other.cellDataView( other_handle );
+                if (data.size != other_data.size)
+                    return false;
+                tasks.push_back( CompareTask{ data.data , other_data.data , nullptr , nullptr , data.size } );
+            }
+            total_elements += tasks.back().size;
+        }
+
+        for (const auto& key : m_face_field_names) {
+            if (!other.hasFaceData( key ))
+                return false;
+
+            const auto& data = getFaceData( key );
+            const auto& other_data = other.getFaceData( key );
+            if (data.size() != other_data.size())
                 return false;
+            tasks.push_back( CompareTask{ data.data() , other_data.data() , nullptr , nullptr , data.size() } );
+            total_elements += data.size();
         }
 
-        for (const auto& face_data : m_face_data) {
-            const auto key = face_data.first;
-            const auto data = face_data.second;
+        auto compareRange = []( const CompareTask& task , size_t begin , size_t end ) {
+            if (task.fdata)
+                return cmp::array_equal<float>( task.fdata + begin , task.other_fdata + begin , end - begin );
+            else
+                return cmp::array_equal<double>( task.data + begin , task.other_data + begin , end - begin );
+        };
 
-            if (other.hasFaceData( key )) {
-                const auto& other_data = other.getFaceData( key );
-                if (!cmp::vector_equal<double>( data , other_data ))
+        if (num_threads < 2 || total_elements < parallel_fill_threshold) {
+            for (const auto& task : tasks) {
+                if (!compareRange( task , 0 , task.size ))
                     return false;
-            } else
-                return false;
+            }
+            return true;
         }
 
-        return true;
+        // Second pass: chop the arrays into chunks and let the team
+        // claim them from a shared counter. The chunk size bounds how
+        // much work a thread performs between looks at the mismatch
+        // flag, so one differing field terminates the whole
+        // comparison quickly - also when the difference is in the
+        // first chunk of the first field.
+        struct CompareChunk {
+            size_t task;
+            size_t begin;
+            size_t end;
+        };
+        std::vector<CompareChunk> chunks;
+        for (size_t task = 0; task < tasks.size(); task++) {
+            for (size_t begin = 0; begin < tasks[ task ].size; begin += parallel_fill_threshold) {
+                const size_t end = std::min( begin + parallel_fill_threshold , tasks[ task ].size );
+                chunks.push_back( CompareChunk{ task , begin , end } );
+            }
+        }
+
+        std::atomic<size_t> next_chunk(0);
+        std::atomic<bool> mismatch(false);
+        auto worker = [&]() {
+            while (!mismatch.load( std::memory_order_relaxed )) {
+                const size_t chunk = next_chunk.fetch_add( 1 , std::memory_order_relaxed );
+                if (chunk >= chunks.size())
+                    return;
+                if (!compareRange( tasks[ chunks[ chunk ].task ] , chunks[ chunk ].begin , chunks[ chunk ].end ))
+                    mismatch.store( true , std::memory_order_relaxed );
+            }
+        };
+
+        std::vector<std::thread> team;
+        for (int t = 1; t < num_threads; t++)
+            team.emplace_back( worker );
+        worker();
+        for (auto& thread : team)
+            thread.join();
+
+        return !mismatch;
     }
 
     size_t SimulationDataContainer::numCellDataComponents( const std::string& name ) const {
-        const auto& data = getCellData( name );
-        return data.size() / m_num_cells;
+        return m_cell_meta[ getCellDataHandle( name ) ].components;
     }
 
 
-    const std::map<std::string, std::vector<double>>& SimulationDataContainer::cellData() const {
-        return m_cell_data;
+    bool SimulationDataContainer::cellDataDirty( const std::string& name ) const {
+        return cellDataDirty( getCellDataHandle( name ));
     }
 
-    std::map<std::string, std::vector<double>>& SimulationDataContainer::cellData() {
-        return m_cell_data;
+    bool SimulationDataContainer::cellDataDirty( FieldHandle handle ) const {
+        const FieldMeta& meta = m_cell_meta[ handle ];
+        return meta.version != meta.clean_version;
+    }
+
+    bool SimulationDataContainer::faceDataDirty( const std::string& name ) const {
+        return faceDataDirty( getFaceDataHandle( name ));
+    }
+
+    bool SimulationDataContainer::faceDataDirty( FieldHandle handle ) const {
+        const FieldMeta& meta = m_face_meta[ handle ];
+        return meta.version != meta.clean_version;
     }
 
-    // This is very deprecated.
-    void SimulationDataContainer::addDefaultFields() {
-        registerCellData("PRESSURE" , 1 , 0.0);
-        registerCellData("SATURATION" , m_num_phases , 0.0);
-        registerCellData("TEMPERATURE" , 1 , 273.15 + 20);
 
-        registerFaceData("FACEPRESSURE" , 1 , 0.0 );
-        registerFaceData("FACEFLUX" , 1 , 0.0 );
+    void SimulationDataContainer::markCellDataClean( const std::string& name ) {
+        markCellDataClean( getCellDataHandle( name ));
+    }
 
-        setReferencePointers();
+    void SimulationDataContainer::markCellDataClean( FieldHandle handle ) {
+        FieldMeta& meta = m_cell_meta[ handle ];
+        meta.clean_version = meta.version;
     }
 
+    void SimulationDataContainer::markFaceDataClean( const std::string& name ) {
+        markFaceDataClean( getFaceDataHandle( name ));
+    }
 
-    void SimulationDataContainer::setReferencePointers()
+    void SimulationDataContainer::markFaceDataClean( FieldHandle handle ) {
+        FieldMeta& meta = m_face_meta[ handle ];
+        meta.clean_version = meta.version;
+    }
+
+    void SimulationDataContainer::markAllClean() {
+        for (auto& meta : m_cell_meta)
+            meta.clean_version = meta.version;
+        for (auto& meta : m_face_meta)
+            meta.clean_version = meta.version;
+    }
+
+
+    std::vector<std::string> SimulationDataContainer::dirtyCellData() const {
+        std::vector<std::string> dirty;
+        for (size_t handle = 0; handle < m_cell_meta.size(); handle++) {
+            if (cellDataDirty( FieldHandle( handle )))
+                dirty.push_back( m_cell_field_names[ handle ] );
+        }
+        return dirty;
+    }
+
+    std::vector<std::string> SimulationDataContainer::dirtyFaceData() const {
+        std::vector<std::string> dirty;
+        for (size_t handle = 0; handle < m_face_meta.size(); handle++) {
+            if (faceDataDirty( FieldHandle( handle )))
+                dirty.push_back( m_face_field_names[ handle ] );
+        }
+        return dirty;
+    }
+
+
+    SimulationDataContainer::CellSubView::CellSubView( SimulationDataContainer& parent , size_t first_cell , size_t num_cells , std::vector<int> ghost_cells ) :
+        m_parent( &parent ),
+        m_first_cell( first_cell ),
+        m_num_cells( num_cells ),
+        m_ghost_cells( std::move( ghost_cells ))
     {
-        // This sets the reference pointers for the fast
-        // accessors, the fields must be created first
-        // by copying or a call to addDefaultFields().
-        pressure_ref_     = &getCellData("PRESSURE");
-        temperature_ref_  = &getCellData("TEMPERATURE");
-        saturation_ref_   = &getCellData("SATURATION");
-        facepressure_ref_ = &getFaceData("FACEPRESSURE");
-        faceflux_ref_     = &getFaceData("FACEFLUX");
+        if (first_cell + num_cells > parent.numCells())
+            OPM_THROW(std::invalid_argument , "The cell range: [" << first_cell << "," << first_cell + num_cells << ") is invalid.");
+        for (int cell : m_ghost_cells) {
+            if (size_t(cell) >= parent.numCells())
+                OPM_THROW(std::invalid_argument , "The ghost cell number: " << cell << " is invalid.");
+        }
+
+        m_ghost_data.resize( parent.m_cell_meta.size() );
+        for (size_t handle = 0; handle < parent.m_cell_meta.size(); handle++) {
+            if (!parent.m_cell_meta[ handle ].fdata)
+                m_ghost_data[ handle ].resize( parent.m_cell_meta[ handle ].components * m_ghost_cells.size() );
+        }
+        updateGhostCells();
+    }
+
+
+    SimulationDataContainer::FieldView SimulationDataContainer::CellSubView::localData( FieldHandle handle ) {
+        const FieldMeta& meta = m_parent->m_cell_meta[ handle ];
+        if (meta.fdata)
+            throw std::logic_error("Float precision fields can not be accessed through a sub-view");
+        if ((meta.components > 1) && (meta.layout == Layout::ComponentMajor))
+            throw std::logic_error("The local slice of a component major field is not contiguous - use localComponent()");
+
+        auto view = m_parent->cellDataView( handle );
+        return FieldView{ view.data + m_first_cell * meta.components , m_num_cells * meta.components };
+    }
+
+
+    SimulationDataContainer::ComponentView SimulationDataContainer::CellSubView::localComponent( FieldHandle handle , size_t component ) {
+        auto view = m_parent->cellDataComponent( handle , component );
+        return ComponentView{ view.data + m_first_cell * view.stride , view.stride , m_num_cells };
+    }
+
+
+    SimulationDataContainer::FieldView SimulationDataContainer::CellSubView::ghostData( FieldHandle handle ) {
+        if (m_parent->m_cell_meta[ handle ].fdata)
+            throw std::logic_error("Float precision fields can not be accessed through a sub-view");
+
+        auto& ghost = m_ghost_data[ handle ];
+        return FieldView{ ghost.data() , ghost.size() };
+    }
+
+
+    void SimulationDataContainer::CellSubView::updateGhostCells() {
+        // The gather goes through the const views, so refreshing the
+        // ghost buffers does not mark the parent's fields dirty.
+        const SimulationDataContainer& parent = *m_parent;
+        for (size_t handle = 0; handle < parent.m_cell_meta.size(); handle++) {
+            const FieldMeta& meta = parent.m_cell_meta[ handle ];
+            if (meta.fdata)
+                continue;
+
+            auto& ghost = m_ghost_data[ handle ];
+            for (size_t component = 0; component < meta.components; component++) {
+                const auto data = parent.cellDataComponent( FieldHandle( handle ) , component );
+                for (size_t i = 0; i < m_ghost_cells.size(); i++)
+                    ghost[ i * meta.components + component ] = data[ m_ghost_cells[i] ];
+            }
+        }
+    }
+
+
+    SimulationDataContainer::CellSubView SimulationDataContainer::cellSubView( size_t first_cell , size_t num_cells , std::vector<int> ghost_cells ) {
+        return CellSubView( *this , first_cell , num_cells , std::move( ghost_cells ));
+    }
+
+
+    uint64_t SimulationDataContainer::cellDataFingerprint( const std::string& name ) const {
+        return cellDataFingerprint( getCellDataHandle( name ));
+    }
+
+    uint64_t SimulationDataContainer::cellDataFingerprint( FieldHandle handle ) const {
+        const FieldMeta& meta = m_cell_meta[ handle ];
+        if (meta.hash_version != meta.version) {
+            if (meta.fdata)
+                meta.hash = hashBytes( meta.fdata->data() , meta.size * sizeof(float) );
+            else {
+                const auto view = cellDataView( handle );
+                meta.hash = hashBytes( view.data , view.size * sizeof(double) );
+            }
+            meta.hash_version = meta.version;
+        }
+        return meta.hash;
+    }
+
+    uint64_t SimulationDataContainer::faceDataFingerprint( const std::string& name ) const {
+        return faceDataFingerprint( getFaceDataHandle( name ));
+    }
+
+    uint64_t SimulationDataContainer::faceDataFingerprint( FieldHandle handle ) const {
+        const FieldMeta& meta = m_face_meta[ handle ];
+        if (meta.hash_version != meta.version) {
+            meta.hash = hashBytes( meta.data->data() , meta.size * sizeof(double) );
+            meta.hash_version = meta.version;
+        }
+        return meta.hash;
+    }
+
+    uint64_t SimulationDataContainer::fingerprint() const {
+        uint64_t digest = hashCombine( hashCombine( m_num_cells , m_num_faces ) , m_num_phases );
+        for (size_t handle = 0; handle < m_cell_meta.size(); handle++) {
+            digest = hashCombine( digest , hashBytes( m_cell_field_names[ handle ].data() , m_cell_field_names[ handle ].size() ));
+            digest = hashCombine( digest , cellDataFingerprint( FieldHandle( handle )));
+        }
+        for (size_t handle = 0; handle < m_face_meta.size(); handle++) {
+            digest = hashCombine( digest , hashBytes( m_face_field_names[ handle ].data() , m_face_field_names[ handle ].size() ));
+            digest = hashCombine( digest , faceDataFingerprint( FieldHandle( handle )));
+        }
+        return digest;
+    }
+
+
+    /*
+      The checkpoint file consists of a header:
+
+        magic                                        8 bytes
+        num_cells num_faces num_phases               3 x uint64
+        num_cell_fields num_face_fields              2 x uint64
+        data_offset cell_doubles                     2 x uint64
+        per cell field: name_length name
+                        components size layout precision offset
+        per face field: name_length name
+                        components size offset
+
+      followed by the raw field data starting at file offset
+      @data_offset. All field offsets are in units of doubles
+      relative to @data_offset, and 64 byte aligned so that the
+      fields keep their arena alignment when the file is mapped.
+    */
+
+    void SimulationDataContainer::save(const std::string& path) const {
+        std::ofstream stream( path , std::ios::binary | std::ios::trunc );
+        if (!stream)
+            OPM_THROW(std::runtime_error , "Failed to open checkpoint file: " << path << " for writing");
+
+        // Assign each field an aligned offset in the data section;
+        // the cell fields first, then the face fields.
+        std::vector<size_t> cell_offsets;
+        std::vector<size_t> face_offsets;
+        size_t data_doubles = 0;
+        auto assignOffset = [&data_doubles]( size_t size ) {
+            size_t offset = data_doubles;
+            if (offset % arena_alignment)
+                offset += arena_alignment - (offset % arena_alignment);
+            data_doubles = offset + size;
+            return offset;
+        };
+        for (const auto& meta : m_cell_meta)
+            cell_offsets.push_back( assignOffset( meta.fdata ? (meta.size + 1) / 2 : meta.size ));
+        const size_t cell_doubles = data_doubles;
+        for (const auto& meta : m_face_meta)
+            face_offsets.push_back( assignOffset( meta.size ));
+
+        size_t header_size = sizeof checkpoint_magic + 7 * sizeof(uint64_t);
+        for (const auto& name : m_cell_field_names)
+            header_size += 6 * sizeof(uint64_t) + name.size();
+        for (const auto& name : m_face_field_names)
+            header_size += 4 * sizeof(uint64_t) + name.size();
+        const size_t data_offset = ((header_size + checkpoint_page - 1) / checkpoint_page) * checkpoint_page;
+
+        stream.write( checkpoint_magic , sizeof checkpoint_magic );
+        writeU64( stream , m_num_cells );
+        writeU64( stream , m_num_faces );
+        writeU64( stream , m_num_phases );
+        writeU64( stream , m_cell_meta.size() );
+        writeU64( stream , m_face_meta.size() );
+        writeU64( stream , data_offset );
+        writeU64( stream , cell_doubles );
+
+        for (size_t handle = 0; handle < m_cell_meta.size(); handle++) {
+            const auto& name = m_cell_field_names[ handle ];
+            const auto& meta = m_cell_meta[ handle ];
+            writeU64( stream , name.size() );
+            stream.write( name.data() , name.size() );
+            writeU64( stream , meta.components );
+            writeU64( stream , meta.size );
+            writeU64( stream , meta.layout == Layout::ComponentMajor ? 1 : 0 );
+            writeU64( stream , meta.fdata ? 1 : 0 );
+            writeU64( stream , cell_offsets[ handle ] );
+        }
+        for (size_t handle = 0; handle < m_face_meta.size(); handle++) {
+            const auto& name = m_face_field_names[ handle ];
+            const auto& meta = m_face_meta[ handle ];
+            writeU64( stream , name.size() );
+            stream.write( name.data() , name.size() );
+            writeU64( stream , meta.components );
+            writeU64( stream , meta.size );
+            writeU64( stream , face_offsets[ handle ] );
+        }
+
+        {
+            const std::vector<char> zeros( data_offset - header_size , 0 );
+            stream.write( zeros.data() , zeros.size() );
+        }
+
+        size_t written = data_offset;
+        auto writeField = [&stream,&written,data_offset]( const void* data , size_t num_bytes , size_t offset ) {
+            const size_t file_offset = data_offset + offset * sizeof(double);
+            if (file_offset > written) {
+                const std::vector<char> zeros( file_offset - written , 0 );
+                stream.write( zeros.data() , zeros.size() );
+            }
+            stream.write( static_cast<const char*>( data ) , num_bytes );
+            written = file_offset + num_bytes;
+        };
+        for (size_t handle = 0; handle < m_cell_meta.size(); handle++) {
+            const auto& meta = m_cell_meta[ handle ];
+            if (meta.fdata)
+                writeField( meta.fdata->data() , meta.size * sizeof(float) , cell_offsets[ handle ] );
+            else {
+                const auto view = cellDataView( FieldHandle( handle ));
+                writeField( view.data , view.size * sizeof(double) , cell_offsets[ handle ] );
+            }
+        }
+        for (size_t handle = 0; handle < m_face_meta.size(); handle++) {
+            const auto& data = getFaceData( FieldHandle( handle ));
+            writeField( data.data() , data.size() * sizeof(double) , face_offsets[ handle ] );
+        }
+
+        if (!stream)
+            OPM_THROW(std::runtime_error , "Failed writing checkpoint file: " << path);
+    }
+
+
+    SimulationDataContainer SimulationDataContainer::load(const std::string& path) {
+        int fd = ::open( path.c_str() , O_RDONLY );
+        if (fd < 0)
+            OPM_THROW(std::runtime_error , "Failed to open checkpoint file: " << path);
+
+        struct stat file_info;
+        if (fstat( fd , &file_info ) != 0) {
+            ::close( fd );
+            OPM_THROW(std::runtime_error , "Failed to stat checkpoint file: " << path);
+        }
+        const size_t file_size = file_info.st_size;
+
+        // MAP_PRIVATE maps the file copy-on-write: reading a field
+        // straight out of the mapping costs nothing beyond the page
+        // faults, and the kernel first copies a page when it is
+        // written to - the file itself is never modified.
+        void* mapping = mmap( nullptr , file_size , PROT_READ | PROT_WRITE , MAP_PRIVATE , fd , 0 );
+        ::close( fd );
+        if (mapping == MAP_FAILED)
+            OPM_THROW(std::runtime_error , "Failed to map checkpoint file: " << path);
+
+        // The guard owns the mapping; the arena pointer below aliases
+        // it, so the file stays mapped for as long as any container
+        // refers to the data.
+        std::shared_ptr<char> map_guard( static_cast<char*>( mapping ) ,
+                                         [file_size]( char* ptr ) { munmap( ptr , file_size ); } );
+
+        const char* cursor = map_guard.get();
+        if ((file_size < sizeof checkpoint_magic + 7 * sizeof(uint64_t)) ||
+            (std::memcmp( cursor , checkpoint_magic , sizeof checkpoint_magic ) != 0))
+            OPM_THROW(std::runtime_error , "The file: " << path << " is not a SimulationDataContainer checkpoint");
+        cursor += sizeof checkpoint_magic;
+
+        const size_t num_cells = readU64( cursor );
+        const size_t num_faces = readU64( cursor );
+        const size_t num_phases = readU64( cursor );
+        const size_t num_cell_fields = readU64( cursor );
+        const size_t num_face_fields = readU64( cursor );
+        const size_t data_offset = readU64( cursor );
+        const size_t cell_doubles = readU64( cursor );
+        if ((data_offset > file_size) || (cell_doubles > (file_size - data_offset) / sizeof(double)))
+            OPM_THROW(std::runtime_error , "The checkpoint file: " << path << " is truncated");
+        const size_t data_doubles = (file_size - data_offset) / sizeof(double);
+
+        // All remaining header reads are bounds checked against the
+        // start of the data section, so a corrupt field count or
+        // name length throws instead of walking off the mapping.
+        const char* const header_end = map_guard.get() + data_offset;
+        auto checkHeader = [&cursor,header_end,&path]( size_t num_bytes ) {
+            if ((cursor > header_end) || (num_bytes > size_t( header_end - cursor )))
+                OPM_THROW(std::runtime_error , "The checkpoint file: " << path << " is truncated");
+        };
+        auto readHeaderU64 = [&cursor,&checkHeader]() {
+            checkHeader( sizeof(uint64_t) );
+            return readU64( cursor );
+        };
+        auto readName = [&cursor,&checkHeader,&readHeaderU64]() {
+            const size_t length = readHeaderU64();
+            checkHeader( length );
+            std::string name( cursor , length );
+            cursor += length;
+            return name;
+        };
+
+        SimulationDataContainer container( num_cells , num_faces , num_phases , Storage::Contiguous );
+        container.m_cell_field_names.clear();
+        container.m_cell_meta.clear();
+        container.m_face_field_names.clear();
+        container.m_face_meta.clear();
+
+        double* arena = reinterpret_cast<double*>( map_guard.get() + data_offset );
+        container.m_cell_arena = std::shared_ptr<double>( map_guard , arena );
+        container.m_cell_arena_size = cell_doubles;
+        container.m_cell_arena_capacity = cell_doubles;
+
+        for (size_t handle = 0; handle < num_cell_fields; handle++) {
+            std::string name = readName();
+            const size_t components = readHeaderU64();
+            const size_t size = readHeaderU64();
+            const Layout layout = readHeaderU64() ? Layout::ComponentMajor : Layout::CellMajor;
+            const bool is_float = readHeaderU64() != 0;
+            const size_t offset = readHeaderU64();
+            const size_t size_doubles = is_float ? (size + 1) / 2 : size;
+            if ((offset > data_doubles) || (size_doubles > data_doubles - offset))
+                OPM_THROW(std::runtime_error , "The checkpoint file: " << path << " is truncated");
+
+            container.m_cell_field_names.push_back( std::move( name ));
+            if (is_float) {
+                // Float fields are always stored individually and are
+                // copied out of the mapping like the face data.
+                const float* field = reinterpret_cast<const float*>( arena + offset );
+                container.m_cell_meta.push_back( FieldMeta{ components , size , 0 , layout , nullptr ,
+                                                            std::make_shared<std::vector<float>>( field , field + size ) , 1 , 0 , 0 , 0 } );
+            } else
+                container.m_cell_meta.push_back( FieldMeta{ components , size , offset , layout , nullptr , nullptr , 1 , 0 , 0 , 0 } );
+        }
+
+        // The face data is typically tiny compared to the cell data
+        // and is copied out of the mapping into ordinary vectors.
+        for (size_t handle = 0; handle < num_face_fields; handle++) {
+            std::string name = readName();
+            const size_t components = readHeaderU64();
+            const size_t size = readHeaderU64();
+            const size_t offset = readHeaderU64();
+            if ((offset > data_doubles) || (size > data_doubles - offset))
+                OPM_THROW(std::runtime_error , "The checkpoint file: " << path << " is truncated");
+
+            container.m_face_field_names.push_back( std::move( name ));
+            container.m_face_meta.push_back( FieldMeta{ components , size , 0 , Layout::CellMajor ,
+                                                        std::make_shared<std::vector<double>>( arena + offset , arena + offset + size ) , nullptr , 1 , 0 , 0 , 0 } );
+        }
+
+        container.pressure_handle_     = container.getCellDataHandle("PRESSURE");
+        container.saturation_handle_   = container.getCellDataHandle("SATURATION");
+        container.temperature_handle_  = container.getCellDataHandle("TEMPERATURE");
+        container.facepressure_handle_ = container.getFaceDataHandle("FACEPRESSURE");
+        container.faceflux_handle_     = container.getFaceDataHandle("FACEFLUX");
+
+        return container;
+    }
+
+
+    const std::vector<std::string>& SimulationDataContainer::cellDataNames() const {
+        return m_cell_field_names;
+    }
+
+    const std::vector<std::string>& SimulationDataContainer::faceDataNames() const {
+        return m_face_field_names;
+    }
+
+    // This is very deprecated.
+    void SimulationDataContainer::addDefaultFields() {
+        pressure_handle_    = registerCellData("PRESSURE" , 1 , 0.0);
+        saturation_handle_  = registerCellData("SATURATION" , m_num_phases , 0.0);
+        temperature_handle_ = registerCellData("TEMPERATURE" , 1 , 273.15 + 20);
+
+        facepressure_handle_ = registerFaceData("FACEPRESSURE" , 1 , 0.0 );
+        faceflux_handle_     = registerFaceData("FACEFLUX" , 1 , 0.0 );
     }
 
 
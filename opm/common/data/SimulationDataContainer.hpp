@@ -21,6 +21,9 @@
 #define SIMULATION_DATA_CONTAINER_HPP
 
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <map>
 #include <vector>
@@ -40,9 +43,108 @@ namespace Opm {
     /// mutable references are returned with the getCellData() and
     /// getFaceData() methods, and the content will typically be
     /// modified by external scope.
+    ///
+    /// Copies of a container share the field buffers copy-on-write:
+    /// the copy constructor only bumps a reference count per field,
+    /// and a private copy of a field is first made when a mutable
+    /// reference or view of it is requested. This makes the common
+    /// pattern of copying the complete state before a trial timestep,
+    /// and discarding the copy when the step succeeds, essentially
+    /// free.
     class SimulationDataContainer
     {
     public:
+        /// Handle for direct O(1) access to a registered field. The
+        /// handle is returned from registerCellData() and
+        /// registerFaceData(), and can be recovered later with
+        /// getCellDataHandle() / getFaceDataHandle(). The name based
+        /// lookup functions should only be used at setup time; in
+        /// performance critical loops the handle overloads of
+        /// getCellData() and getFaceData() should be used instead -
+        /// they resolve without any string comparison.
+        typedef size_t FieldHandle;
+
+        /// How the cell data fields are stored:
+        ///
+        ///   Individual: each field is an independently allocated
+        ///      std::vector<double> - this is the default, and the
+        ///      only mode where the std::vector<double> reference
+        ///      accessors can be used.
+        ///
+        ///   Contiguous: all cell fields are carved out of one large
+        ///      arena owned by the container, with each field starting
+        ///      on a 64 byte aligned offset. The fields must then be
+        ///      accessed with the cellDataView() methods; this layout
+        ///      keeps the whole cell state in one allocation which is
+        ///      friendly to the cache and can be handed off to e.g.
+        ///      MPI as a single buffer. Face data is always stored
+        ///      individually. Copy-on-write detaches the arena as one
+        ///      unit.
+        enum class Storage { Individual, Contiguous };
+
+        /// How the components of a multi component field are laid
+        /// out in memory:
+        ///
+        ///   CellMajor: all components of one cell are adjacent,
+        ///      i.e. [P0 S0 T0 P1 S1 T1 ...] - this is the historic
+        ///      default layout.
+        ///
+        ///   ComponentMajor: each component is one contiguous
+        ///      stream, i.e. [P0 P1 ... S0 S1 ... T0 T1 ...] - this
+        ///      is the layout vectorized per-component kernels want.
+        enum class Layout { CellMajor, ComponentMajor };
+
+        /// The storage precision of a field. Fields like saturations
+        /// and tracer concentrations rarely need more than single
+        /// precision, and storing them as float halves the memory
+        /// footprint and bandwidth of the kernels touching them.
+        /// Float fields are always stored individually - also in
+        /// contiguous storage mode - and must be accessed with the
+        /// getCellDataFloat() accessors; cellDataAsDouble() offers a
+        /// converting copy for code which needs doubles.
+        enum class Precision { Double, Float };
+
+        /// Non owning view of (a part of) a field; the pointer is
+        /// only valid until the next field registration or copy
+        /// related detach.
+        struct FieldView {
+            double* data;
+            size_t size;
+
+            double& operator[](size_t index) { return data[index]; }
+            double* begin() { return data; }
+            double* end() { return data + size; }
+        };
+
+        struct ConstFieldView {
+            const double* data;
+            size_t size;
+
+            double operator[](size_t index) const { return data[index]; }
+            const double* begin() const { return data; }
+            const double* end() const { return data + size; }
+        };
+
+        /// Strided view of one component of a field; indexed by cell
+        /// number irrespective of the underlying layout. The stride
+        /// is 1 for ComponentMajor fields, so kernels can detect the
+        /// contiguous case and vectorize accordingly.
+        struct ComponentView {
+            double* data;
+            size_t stride;
+            size_t num_cells;
+
+            double& operator[](size_t cell) { return data[cell * stride]; }
+        };
+
+        struct ConstComponentView {
+            const double* data;
+            size_t stride;
+            size_t num_cells;
+
+            double operator[](size_t cell) const { return data[cell * stride]; }
+        };
+
         /// Main constructor setting the sizes for the contained data
         /// types.
         /// \param num_cells   number of elements in cell data vectors
@@ -52,38 +154,138 @@ namespace Opm {
         ///                    number (this behaviour and argument is deprecated).
         SimulationDataContainer(size_t num_cells, size_t num_faces, size_t num_phases);
 
-        /// Copy constructor.
-        /// Must be defined explicitly because class contains non-value objects
-        /// (the reference pointers pressure_ref_ etc.) that should not simply
-        /// be copied.
+        /// Constructor selecting the storage mode explicitly. With
+        /// Storage::Contiguous the arena is sized for the default
+        /// fields plus a few extra at construction time and will only
+        /// grow if many additional fields are registered. Observe
+        /// that the deprecated direct accessors pressure() etc. can
+        /// not be used in contiguous mode.
+        SimulationDataContainer(size_t num_cells, size_t num_faces, size_t num_phases, Storage storage);
+
+        /// Copy constructor. The copy shares the field buffers with
+        /// the source container copy-on-write; a private copy of a
+        /// field is made when it is first accessed mutably.
         SimulationDataContainer(const SimulationDataContainer&);
 
-        /// Copy assignment operator.
-        /// Must be defined explicitly because class contains non-value objects
-        /// (the reference pointers pressure_ref_ etc.) that should not simply
-        /// be copied.
+        /// Copy assignment operator, with the same copy-on-write
+        /// semantics as the copy constructor.
         SimulationDataContainer& operator=(const SimulationDataContainer&);
 
+        /// Move construction and assignment steal the field buffers
+        /// without touching the data; the moved-from container must
+        /// not be used afterwards, except to destroy or assign to it.
+        SimulationDataContainer(SimulationDataContainer&&) = default;
+        SimulationDataContainer& operator=(SimulationDataContainer&&) = default;
+
         /// Efficient O(1) swap.
         void swap(SimulationDataContainer& other);
 
+        /// Set the number of threads used to fill the data of newly
+        /// registered fields. With more than one thread the fill is
+        /// done with a static partition of the index range, matching
+        /// the scheduling of a static OpenMP cell loop, so that on
+        /// NUMA systems the pages land on the nodes which will later
+        /// work on them. True first-touch placement requires the
+        /// contiguous storage mode, where the arena capacity is
+        /// reserved without touching the pages; in individual storage
+        /// mode the std::vector allocation has already touched the
+        /// pages once and the parallel fill only speeds up setup.
+        /// The setting is process global; the default is 1 (serial).
+        static void setInitializationThreads(int num_threads);
+        static int initializationThreads();
+
         size_t numPhases() const;
         size_t numFaces() const;
         size_t numCells() const;
+        Storage storage() const;
 
         bool hasCellData( const std::string& name ) const;
 
         /// Will register a data vector of size numCells() *
-        /// components.
-        void registerCellData( const std::string& name , size_t components , double initialValue = 0.0 );
+        /// components. The returned handle can be used for O(1)
+        /// access with getCellData(FieldHandle); if the field is
+        /// already registered the handle of the existing field is
+        /// returned.
+        FieldHandle registerCellData( const std::string& name , size_t components , double initialValue = 0.0 );
+
+        /// Registration with an explicit component layout; the plain
+        /// overload registers with the default Layout::CellMajor.
+        FieldHandle registerCellData( const std::string& name , size_t components , Layout layout , double initialValue = 0.0 );
+
+        /// Registration which adopts an already computed data vector
+        /// instead of default-filling a new one; the vector must have
+        /// size numCells() * components. In individual storage mode
+        /// the buffer is taken over without copying; in contiguous
+        /// storage mode the data is copied into the arena.
+        FieldHandle registerCellData( const std::string& name , size_t components , std::vector<double>&& data , Layout layout = Layout::CellMajor );
+
+        /// Registration with an explicit storage precision; with
+        /// Precision::Double this is identical to the plain overload.
+        FieldHandle registerCellData( const std::string& name , size_t components , Precision precision , double initialValue = 0.0 );
         std::vector<double>& getCellData( const std::string& name );
         const std::vector<double>& getCellData( const std::string& name ) const;
 
+        /// Will return the handle of an already registered cell data
+        /// field; throws std::invalid_argument if the field does not
+        /// exist. Should only be called at setup time.
+        FieldHandle getCellDataHandle( const std::string& name ) const;
+
+        /// O(1) access to a cell data field using the handle obtained
+        /// at registration time. The handle is not validated. Throws
+        /// std::logic_error in contiguous storage mode, where there is
+        /// no per field vector - use cellDataView() instead.
+        std::vector<double>& getCellData( FieldHandle handle );
+        const std::vector<double>& getCellData( FieldHandle handle ) const;
+
+        /// View based access to a cell data field; this works in both
+        /// storage modes. The view is invalidated by registering
+        /// another field.
+        FieldView cellDataView( const std::string& name );
+        ConstFieldView cellDataView( const std::string& name ) const;
+        FieldView cellDataView( FieldHandle handle );
+        ConstFieldView cellDataView( FieldHandle handle ) const;
+
+        /// Strided view of component @component of a cell data
+        /// field, valid for both layouts and both storage modes.
+        ComponentView cellDataComponent( const std::string& name , size_t component );
+        ConstComponentView cellDataComponent( const std::string& name , size_t component ) const;
+        ComponentView cellDataComponent( FieldHandle handle , size_t component );
+        ConstComponentView cellDataComponent( FieldHandle handle , size_t component ) const;
+
+        Layout cellDataLayout( const std::string& name ) const;
+        Layout cellDataLayout( FieldHandle handle ) const;
+
+        Precision cellDataPrecision( const std::string& name ) const;
+        Precision cellDataPrecision( FieldHandle handle ) const;
+
+        /// Native access to a float precision field; throws
+        /// std::logic_error for double precision fields, exactly like
+        /// getCellData() throws for float precision ones.
+        std::vector<float>& getCellDataFloat( const std::string& name );
+        const std::vector<float>& getCellDataFloat( const std::string& name ) const;
+        std::vector<float>& getCellDataFloat( FieldHandle handle );
+        const std::vector<float>& getCellDataFloat( FieldHandle handle ) const;
+
+        /// Converting copy of a field as doubles irrespective of the
+        /// storage precision; meant for output and other cold paths -
+        /// hot kernels should use the native accessors.
+        std::vector<double> cellDataAsDouble( const std::string& name ) const;
+        std::vector<double> cellDataAsDouble( FieldHandle handle ) const;
+
+        /// One time in place conversion between the two layouts;
+        /// a no-op if the field already has the requested layout.
+        void convertCellDataLayout( const std::string& name , Layout layout );
+        void convertCellDataLayout( FieldHandle handle , Layout layout );
+
         bool hasFaceData( const std::string& name ) const;
-        void registerFaceData( const std::string& name , size_t components , double initialValue = 0.0 );
+        FieldHandle registerFaceData( const std::string& name , size_t components , double initialValue = 0.0 );
         std::vector<double>& getFaceData( const std::string& name );
         const std::vector<double>& getFaceData( const std::string& name ) const;
 
+        FieldHandle getFaceDataHandle( const std::string& name ) const;
+        std::vector<double>& getFaceData( FieldHandle handle );
+        const std::vector<double>& getFaceData( FieldHandle handle ) const;
+
         /// Will return the number of components of the celldata with
         /// name @name:
         ///
@@ -92,7 +294,25 @@ namespace Opm {
         ///
         /// for a three phase model.
         size_t numCellDataComponents( const std::string& name ) const;
+
+        /// Will compare the content of the two containers. The
+        /// structure - field names, precision, component counts,
+        /// sizes and (for multi component fields) component layout -
+        /// is checked first, so containers of different shape are
+        /// rejected without touching any field data. Two containers
+        /// holding the same values in different layouts compare
+        /// unequal: the layout is treated as part of the container
+        /// structure, like the precision. Storage mode on the other
+        /// hand is transparent - contiguous and individual
+        /// containers with the same fields compare equal. The
+        /// element wise comparison uses the cmp::array_equal()
+        /// tolerances. The overload taking
+        /// @num_threads spreads the element wise comparison of the
+        /// fields over that many threads, with early termination
+        /// across the whole team as soon as any chunk reports a
+        /// difference; small states are always compared serially.
         bool equal(const SimulationDataContainer& other) const;
+        bool equal(const SimulationDataContainer& other , int num_threads) const;
 
 
         /// Will set the values of component nr @component in the
@@ -100,6 +320,130 @@ namespace Opm {
         /// values in @values.
         void setCellDataComponent( const std::string& key , size_t component , const std::vector<int>& cells , const std::vector<double>& values);
 
+        /// One batched component update for applyCellDataUpdates().
+        /// If @cells is non null it points to @count cell indices and
+        /// cell cells[i] is set to values[i]; if @cells is null the
+        /// update targets the contiguous cell range [first_cell,
+        /// first_cell + count), which degenerates to a memcpy for
+        /// component major fields.
+        struct ComponentUpdate {
+            FieldHandle field;
+            size_t component;
+            const int* cells;
+            size_t first_cell;
+            const double* values;
+            size_t count;
+        };
+
+        /// Will apply a batch of component updates in one call. All
+        /// the updates are validated before anything is written, so a
+        /// throwing call leaves the container untouched; the scatter
+        /// loop itself then runs without any per element checks. Use
+        /// this instead of repeated setCellDataComponent() calls in
+        /// hot paths like the well control updates.
+        void applyCellDataUpdates( const std::vector<ComponentUpdate>& updates );
+
+        /// Modification tracking for incremental output: every field
+        /// carries a version counter which is bumped each time a
+        /// mutable reference or view of the field is handed out, and
+        /// the field counts as dirty until markCellDataClean() /
+        /// markFaceDataClean() is called for it. A writer can then
+        /// skip the fields which have not been touched since the
+        /// previous report step. The tracking is conservative -
+        /// taking a mutable reference marks the field dirty whether
+        /// or not anything is actually written through it. Newly
+        /// registered fields start out dirty.
+        bool cellDataDirty( const std::string& name ) const;
+        bool cellDataDirty( FieldHandle handle ) const;
+        bool faceDataDirty( const std::string& name ) const;
+        bool faceDataDirty( FieldHandle handle ) const;
+
+        void markCellDataClean( const std::string& name );
+        void markCellDataClean( FieldHandle handle );
+        void markFaceDataClean( const std::string& name );
+        void markFaceDataClean( FieldHandle handle );
+
+        /// Will mark all cell and face data fields as clean.
+        void markAllClean();
+
+        /// The names of the currently dirty cell/face data fields,
+        /// in registration order.
+        std::vector<std::string> dirtyCellData() const;
+        std::vector<std::string> dirtyFaceData() const;
+
+        /// Fast non-cryptographic 64 bit fingerprint of a field, so
+        /// that e.g. MPI ranks can compare 8 byte digests instead of
+        /// gathering and comparing complete vectors. The fingerprint
+        /// is computed lazily and cached; the cache is invalidated by
+        /// the same version counters which drive the dirty tracking,
+        /// so repeated queries of an untouched field are O(1). Note
+        /// that the fingerprint hashes the raw bits - two fields
+        /// which only compare equal within an epsilon will have
+        /// different fingerprints.
+        uint64_t cellDataFingerprint( const std::string& name ) const;
+        uint64_t cellDataFingerprint( FieldHandle handle ) const;
+        uint64_t faceDataFingerprint( const std::string& name ) const;
+        uint64_t faceDataFingerprint( FieldHandle handle ) const;
+
+        /// Combined fingerprint of the container: the dimensions, the
+        /// field names in registration order and the per field
+        /// fingerprints.
+        uint64_t fingerprint() const;
+
+        /// Lightweight sub-view over a contiguous range of the
+        /// parent's cells plus a list of ghost cells, for domain
+        /// decomposition. The local cell range aliases the parent's
+        /// field memory directly, so building the per rank views -
+        /// and rebuilding them when repartitioning - is pointer
+        /// arithmetic; only the ghost cells are copied, into small
+        /// per field buffers refreshed with updateGhostCells(). A
+        /// sub-view holds a pointer to the parent container and must
+        /// not outlive it; it is invalidated by registering further
+        /// fields in the parent. Float precision fields can not be
+        /// accessed through a sub-view.
+        class CellSubView {
+        public:
+            size_t firstCell() const { return m_first_cell; }
+            size_t numLocalCells() const { return m_num_cells; }
+            size_t numGhostCells() const { return m_ghost_cells.size(); }
+            const std::vector<int>& ghostCells() const { return m_ghost_cells; }
+
+            /// View of the local slice of the field, aliasing the
+            /// parent's memory. Throws std::logic_error for multi
+            /// component fields with ComponentMajor layout, where
+            /// the local slice is not one contiguous block - use
+            /// localComponent() for those.
+            FieldView localData( FieldHandle handle );
+
+            /// Strided view of one component of the local slice,
+            /// indexed by local cell number; valid for both layouts.
+            ComponentView localComponent( FieldHandle handle , size_t component );
+
+            /// The ghost cell buffer of the field: numGhostCells()
+            /// cells in cell major order, following the order of
+            /// ghostCells().
+            FieldView ghostData( FieldHandle handle );
+
+            /// Will re-gather the values of all ghost cells from the
+            /// parent container into the ghost buffers.
+            void updateGhostCells();
+
+        private:
+            friend class SimulationDataContainer;
+            CellSubView( SimulationDataContainer& parent , size_t first_cell , size_t num_cells , std::vector<int> ghost_cells );
+
+            SimulationDataContainer* m_parent;
+            size_t m_first_cell;
+            size_t m_num_cells;
+            std::vector<int> m_ghost_cells;
+            std::vector<std::vector<double>> m_ghost_data;
+        };
+
+        /// Will create a sub-view of the cell range [first_cell,
+        /// first_cell + num_cells) with the given ghost cells; both
+        /// the range and the ghost cell numbers are validated.
+        CellSubView cellSubView( size_t first_cell , size_t num_cells , std::vector<int> ghost_cells = std::vector<int>() );
+
         // Direct explicit field access for certain default fields.
         // These methods are all deprecated, and will eventually be moved to
         // concrete subclasses.
@@ -118,25 +462,91 @@ namespace Opm {
         const std::vector<double>& facepressure() const;
         const std::vector<double>& faceflux    () const;
 
-        const std::map<std::string, std::vector<double>>& cellData() const;
-        std::map<std::string, std::vector<double>>& cellData();
+        /// Will write the complete container state to a binary
+        /// checkpoint file: a versioned header describing the
+        /// registered fields followed by the raw field data, with the
+        /// data section starting on a page boundary so that load()
+        /// can map it directly.
+        void save(const std::string& path) const;
+
+        /// Will restore a container from a file written with save().
+        /// The file is mapped copy-on-write (MAP_PRIVATE) and the
+        /// cell fields alias the mapping, so restoring a large state
+        /// costs page faults instead of a full read plus copy; the
+        /// kernel copies a page first when it is written to. The
+        /// returned container uses contiguous storage mode. Face
+        /// data, which is typically small, is copied out of the file.
+        static SimulationDataContainer load(const std::string& path);
+
+        /// The names of the registered cell data fields, in
+        /// registration order. Use together with getCellData() /
+        /// cellDataView() to iterate all fields - this replaces the
+        /// old cellData() map accessor, which could not be kept when
+        /// the fields became copy-on-write shared.
+        const std::vector<std::string>& cellDataNames() const;
+        const std::vector<std::string>& faceDataNames() const;
 
     private:
+        // Per field bookkeeping; indexed by FieldHandle. The data
+        // member holds the (possibly shared) field buffer in
+        // individual storage mode, and is null for cell fields in
+        // contiguous storage mode where the field instead lives in
+        // the arena at the stored offset.
+        struct FieldMeta {
+            size_t components;
+            size_t size;
+            size_t offset;
+            Layout layout;
+            std::shared_ptr<std::vector<double>> data;
+            // Non null for float precision fields, which are always
+            // stored individually; data is then null.
+            std::shared_ptr<std::vector<float>> fdata;
+            // Modification tracking: the field is dirty when the two
+            // counters differ; version is bumped on mutable access
+            // and clean_version caught up by the markClean methods.
+            size_t version;
+            size_t clean_version;
+            // Cached fingerprint, valid when hash_version == version;
+            // mutable so that the lazy computation can run from the
+            // const fingerprint accessors.
+            mutable size_t hash_version;
+            mutable uint64_t hash;
+        };
+
         void addDefaultFields();
-        void setReferencePointers();
+        void detachCellField( FieldHandle handle );
+        void detachFaceField( FieldHandle handle );
+        void detachCellArena();
+        void growCellArena( size_t capacity );
+        size_t allocateCellArena( size_t size );
 
         size_t m_num_cells;
         size_t m_num_faces;
         size_t m_num_phases;
-
-        std::map< std::string , std::vector<double> > m_cell_data;
-        std::map< std::string , std::vector<double> > m_face_data;
-
-        std::vector<double>* pressure_ref_;
-        std::vector<double>* temperature_ref_;
-        std::vector<double>* saturation_ref_;
-        std::vector<double>* facepressure_ref_;
-        std::vector<double>* faceflux_ref_;
+        Storage m_storage;
+
+        // Field names in registration order, i.e. indexed by
+        // FieldHandle like the meta vectors.
+        std::vector<std::string> m_cell_field_names;
+        std::vector<FieldMeta> m_cell_meta;
+        std::vector<std::string> m_face_field_names;
+        std::vector<FieldMeta> m_face_meta;
+
+        // The arena is a raw 64 byte aligned allocation so that the
+        // reserved capacity is not touched before the parallel
+        // first-touch fill of each registered field.
+        std::shared_ptr<double> m_cell_arena;
+        size_t m_cell_arena_size = 0;
+        size_t m_cell_arena_capacity = 0;
+
+        static int s_initialization_threads;
+
+        // Cached handles for the deprecated direct accessors.
+        FieldHandle pressure_handle_;
+        FieldHandle temperature_handle_;
+        FieldHandle saturation_handle_;
+        FieldHandle facepressure_handle_;
+        FieldHandle faceflux_handle_;
     };
 
 
@@ -144,44 +554,121 @@ namespace Opm {
     // performance.
 
 
+    inline std::vector<double>& SimulationDataContainer::getCellData( FieldHandle handle ) {
+        FieldMeta& meta = m_cell_meta[ handle ];
+        if (meta.fdata)
+            throw std::logic_error("The field has float precision - use getCellDataFloat()");
+        if (!meta.data)
+            throw std::logic_error("Vector access to cell data is not possible in contiguous storage mode - use cellDataView()");
+        if (!meta.data.unique())
+            detachCellField( handle );
+        meta.version++;
+        return *meta.data;
+    }
+
+    inline const std::vector<double>& SimulationDataContainer::getCellData( FieldHandle handle ) const {
+        const FieldMeta& meta = m_cell_meta[ handle ];
+        if (meta.fdata)
+            throw std::logic_error("The field has float precision - use getCellDataFloat()");
+        if (!meta.data)
+            throw std::logic_error("Vector access to cell data is not possible in contiguous storage mode - use cellDataView()");
+        return *meta.data;
+    }
+
+    inline std::vector<float>& SimulationDataContainer::getCellDataFloat( FieldHandle handle ) {
+        FieldMeta& meta = m_cell_meta[ handle ];
+        if (!meta.fdata)
+            throw std::logic_error("The field has double precision - use getCellData()/cellDataView()");
+        if (!meta.fdata.unique())
+            detachCellField( handle );
+        meta.version++;
+        return *meta.fdata;
+    }
+
+    inline const std::vector<float>& SimulationDataContainer::getCellDataFloat( FieldHandle handle ) const {
+        const FieldMeta& meta = m_cell_meta[ handle ];
+        if (!meta.fdata)
+            throw std::logic_error("The field has double precision - use getCellData()/cellDataView()");
+        return *meta.fdata;
+    }
+
+    inline std::vector<double>& SimulationDataContainer::getFaceData( FieldHandle handle ) {
+        FieldMeta& meta = m_face_meta[ handle ];
+        if (!meta.data.unique())
+            detachFaceField( handle );
+        meta.version++;
+        return *meta.data;
+    }
+
+    inline const std::vector<double>& SimulationDataContainer::getFaceData( FieldHandle handle ) const {
+        return *m_face_meta[ handle ].data;
+    }
+
+    inline SimulationDataContainer::FieldView SimulationDataContainer::cellDataView( FieldHandle handle ) {
+        FieldMeta& meta = m_cell_meta[ handle ];
+        if (meta.fdata)
+            throw std::logic_error("The field has float precision - use getCellDataFloat()");
+        meta.version++;
+        if (m_storage == Storage::Contiguous) {
+            if (!m_cell_arena.unique())
+                detachCellArena();
+            return FieldView{ m_cell_arena.get() + meta.offset , meta.size };
+        } else {
+            if (!meta.data.unique())
+                detachCellField( handle );
+            return FieldView{ meta.data->data() , meta.size };
+        }
+    }
+
+    inline SimulationDataContainer::ConstFieldView SimulationDataContainer::cellDataView( FieldHandle handle ) const {
+        const FieldMeta& meta = m_cell_meta[ handle ];
+        if (meta.fdata)
+            throw std::logic_error("The field has float precision - use getCellDataFloat()");
+        if (m_storage == Storage::Contiguous)
+            return ConstFieldView{ m_cell_arena.get() + meta.offset , meta.size };
+        else
+            return ConstFieldView{ meta.data->data() , meta.size };
+    }
+
+
     inline std::vector<double>& SimulationDataContainer::pressure( ) {
-        return *pressure_ref_;
+        return getCellData( pressure_handle_ );
     }
 
     inline std::vector<double>& SimulationDataContainer::temperature() {
-        return *temperature_ref_;
+        return getCellData( temperature_handle_ );
     }
 
     inline std::vector<double>& SimulationDataContainer::saturation() {
-        return *saturation_ref_;
+        return getCellData( saturation_handle_ );
     }
 
     inline std::vector<double>& SimulationDataContainer::facepressure() {
-        return *facepressure_ref_;
+        return getFaceData( facepressure_handle_ );
     }
 
     inline std::vector<double>& SimulationDataContainer::faceflux() {
-        return *faceflux_ref_;
+        return getFaceData( faceflux_handle_ );
     }
 
     inline const std::vector<double>& SimulationDataContainer::pressure( ) const {
-        return *pressure_ref_;
+        return getCellData( pressure_handle_ );
     }
 
     inline const std::vector<double>& SimulationDataContainer::temperature() const {
-        return *temperature_ref_;
+        return getCellData( temperature_handle_ );
     }
 
     inline const std::vector<double>& SimulationDataContainer::saturation() const {
-        return *saturation_ref_;
+        return getCellData( saturation_handle_ );
     }
 
     inline const std::vector<double>& SimulationDataContainer::facepressure() const {
-        return *facepressure_ref_;
+        return getFaceData( facepressure_handle_ );
     }
 
     inline const std::vector<double>& SimulationDataContainer::faceflux() const {
-        return *faceflux_ref_;
+        return getFaceData( faceflux_handle_ );
     }
 
 
@@ -0,0 +1,290 @@
+/*
+  Copyright 2016 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstring>
+
+#include <opm/common/ErrorMacros.hpp>
+#include <opm/common/data/TimeSeriesRecorder.hpp>
+
+namespace Opm {
+
+    namespace {
+
+        const char timeseries_magic[8] = { 'O','P','M','T','S','R','0','1' };
+
+        void writeU64( std::ostream& stream , uint64_t value ) {
+            stream.write( reinterpret_cast<const char*>( &value ) , sizeof value );
+        }
+
+        uint64_t readU64( std::istream& stream ) {
+            uint64_t value = 0;
+            stream.read( reinterpret_cast<char*>( &value ) , sizeof value );
+            return value;
+        }
+
+        template <typename T>
+        void appendValue( std::vector<char>& record , T value ) {
+            const char* bytes = reinterpret_cast<const char*>( &value );
+            record.insert( record.end() , bytes , bytes + sizeof value );
+        }
+
+    }
+
+    /*
+      The recorder file consists of a header:
+
+        magic                                        8 bytes
+        num_probes data_offset record_size           3 x uint64
+        per probe: name_length name
+                   field_length field
+                   precision num_indices
+                   indices
+
+      followed by one fixed width record per recorded step:
+
+        step                                         uint64
+        time                                         double
+        per probe: the gathered values, as double or
+                   float according to the probe precision
+
+      All records have the same size, so a reader can compute the
+      number of complete records from the file size alone and follow
+      a file which is still being appended to.
+    */
+
+    TimeSeriesRecorder::TimeSeriesRecorder(const std::string& path) :
+        m_path( path )
+    {
+        m_stream.open( path.c_str() , std::ios::binary | std::ios::trunc );
+        if (!m_stream)
+            OPM_THROW(std::runtime_error , "Failed to open time series file: " << path << " for writing");
+    }
+
+
+    void TimeSeriesRecorder::addProbe(const std::string& probe_name , const std::string& field_name , std::vector<size_t> indices , Precision precision) {
+        if (m_frozen)
+            throw std::logic_error("Can not add probes after the first step has been recorded");
+
+        if (indices.empty())
+            throw std::invalid_argument("A probe must select at least one element");
+
+        for (const auto& probe : m_probes) {
+            if (probe.name == probe_name)
+                throw std::invalid_argument("The probe: " + probe_name + " is already registered");
+        }
+
+        m_probes.push_back( Probe{ probe_name , field_name , std::move( indices ) , precision } );
+    }
+
+
+    void TimeSeriesRecorder::writeHeader() {
+        size_t record_size = sizeof(uint64_t) + sizeof(double);
+        for (const auto& probe : m_probes)
+            record_size += probe.indices.size() * (probe.precision == Precision::Float ? sizeof(float) : sizeof(double));
+
+        m_stream.write( timeseries_magic , sizeof timeseries_magic );
+
+        size_t header_size = sizeof timeseries_magic + 3 * sizeof(uint64_t);
+        for (const auto& probe : m_probes)
+            header_size += (4 + probe.indices.size()) * sizeof(uint64_t) + probe.name.size() + probe.field.size();
+
+        writeU64( m_stream , m_probes.size() );
+        writeU64( m_stream , header_size );
+        writeU64( m_stream , record_size );
+
+        for (const auto& probe : m_probes) {
+            writeU64( m_stream , probe.name.size() );
+            m_stream.write( probe.name.data() , probe.name.size() );
+            writeU64( m_stream , probe.field.size() );
+            m_stream.write( probe.field.data() , probe.field.size() );
+            writeU64( m_stream , probe.precision == Precision::Float ? 1 : 0 );
+            writeU64( m_stream , probe.indices.size() );
+            for (size_t index : probe.indices)
+                writeU64( m_stream , index );
+        }
+        m_stream.flush();
+
+        m_record_size = record_size;
+        m_record.reserve( record_size );
+        m_frozen = true;
+    }
+
+
+    void TimeSeriesRecorder::recordStep(const SimulationDataContainer& state , double time) {
+        if (!m_frozen) {
+            if (m_probes.empty())
+                throw std::logic_error("Can not record a step before any probes have been added");
+            writeHeader();
+        }
+
+        m_record.clear();
+        appendValue<uint64_t>( m_record , m_num_steps );
+        appendValue<double>( m_record , time );
+
+        for (const auto& probe : m_probes) {
+            if (state.cellDataPrecision( probe.field ) == Precision::Float) {
+                const auto& data = state.getCellDataFloat( probe.field );
+                for (size_t index : probe.indices) {
+                    if (index >= data.size())
+                        OPM_THROW(std::invalid_argument , "Probe " << probe.name << ": index " << index << " is out of range for field " << probe.field);
+                    if (probe.precision == Precision::Float)
+                        appendValue<float>( m_record , data[ index ] );
+                    else
+                        appendValue<double>( m_record , data[ index ] );
+                }
+            } else {
+                const auto view = state.cellDataView( probe.field );
+                for (size_t index : probe.indices) {
+                    if (index >= view.size)
+                        OPM_THROW(std::invalid_argument , "Probe " << probe.name << ": index " << index << " is out of range for field " << probe.field);
+                    if (probe.precision == Precision::Float)
+                        appendValue<float>( m_record , static_cast<float>( view.data[ index ] ));
+                    else
+                        appendValue<double>( m_record , view.data[ index ] );
+                }
+            }
+        }
+
+        /* One write per record followed by a flush, so that a
+           concurrent reader either sees the complete record or a
+           short tail - never interleaved partial probes. */
+        m_stream.write( m_record.data() , m_record.size() );
+        m_stream.flush();
+        if (!m_stream)
+            OPM_THROW(std::runtime_error , "Failed writing time series file: " << m_path);
+        m_num_steps++;
+    }
+
+
+    size_t TimeSeriesRecorder::numProbes() const {
+        return m_probes.size();
+    }
+
+    size_t TimeSeriesRecorder::numSteps() const {
+        return m_num_steps;
+    }
+
+
+    /*****************************************************************/
+
+    TimeSeriesReader::TimeSeriesReader(const std::string& path) :
+        m_path( path )
+    {
+        m_stream.open( path.c_str() , std::ios::binary );
+        if (!m_stream)
+            OPM_THROW(std::runtime_error , "Failed to open time series file: " << path);
+
+        char magic[ sizeof timeseries_magic ];
+        m_stream.read( magic , sizeof magic );
+        if (!m_stream || std::memcmp( magic , timeseries_magic , sizeof magic ) != 0)
+            OPM_THROW(std::runtime_error , "The file: " << path << " is not a time series file");
+
+        const uint64_t num_probes = readU64( m_stream );
+        m_data_offset = readU64( m_stream );
+        m_record_size = readU64( m_stream );
+
+        size_t record_offset = sizeof(uint64_t) + sizeof(double);
+        for (uint64_t probe = 0; probe < num_probes; probe++) {
+            ProbeInfo info;
+            info.name.resize( readU64( m_stream ));
+            m_stream.read( &info.name[0] , info.name.size() );
+            info.field.resize( readU64( m_stream ));
+            m_stream.read( &info.field[0] , info.field.size() );
+            info.fvalues = (readU64( m_stream ) == 1);
+            info.num_values = readU64( m_stream );
+            for (size_t index = 0; index < info.num_values; index++)
+                readU64( m_stream );
+            info.record_offset = record_offset;
+            record_offset += info.num_values * (info.fvalues ? sizeof(float) : sizeof(double));
+            m_probes.push_back( std::move( info ));
+        }
+        if (!m_stream || record_offset != m_record_size)
+            OPM_THROW(std::runtime_error , "The time series file: " << path << " has a corrupt header");
+    }
+
+
+    size_t TimeSeriesReader::numProbes() const {
+        return m_probes.size();
+    }
+
+    const std::string& TimeSeriesReader::probeName(size_t probe) const {
+        return m_probes.at( probe ).name;
+    }
+
+    const std::string& TimeSeriesReader::fieldName(size_t probe) const {
+        return m_probes.at( probe ).field;
+    }
+
+    size_t TimeSeriesReader::probeSize(size_t probe) const {
+        return m_probes.at( probe ).num_values;
+    }
+
+
+    size_t TimeSeriesReader::numSteps() {
+        /* The file size is re-examined on every call so that a
+           reader following a live file sees steps as they complete;
+           the integer division discards a torn record at the tail. */
+        m_stream.clear();
+        m_stream.seekg( 0 , std::ios::end );
+        const size_t file_size = m_stream.tellg();
+        if (file_size < m_data_offset)
+            return 0;
+        return (file_size - m_data_offset) / m_record_size;
+    }
+
+
+    void TimeSeriesReader::seekRecord(size_t step , size_t offset) {
+        if (step >= numSteps())
+            throw std::invalid_argument("Invalid step number");
+        m_stream.seekg( m_data_offset + step * m_record_size + offset );
+    }
+
+
+    uint64_t TimeSeriesReader::stepIndex(size_t step) {
+        seekRecord( step , 0 );
+        return readU64( m_stream );
+    }
+
+    double TimeSeriesReader::stepTime(size_t step) {
+        seekRecord( step , sizeof(uint64_t) );
+        double time = 0;
+        m_stream.read( reinterpret_cast<char*>( &time ) , sizeof time );
+        return time;
+    }
+
+
+    std::vector<double> TimeSeriesReader::values(size_t step , size_t probe) {
+        const ProbeInfo& info = m_probes.at( probe );
+        seekRecord( step , info.record_offset );
+
+        std::vector<double> values( info.num_values );
+        if (info.fvalues) {
+            std::vector<float> fvalues( info.num_values );
+            m_stream.read( reinterpret_cast<char*>( fvalues.data() ) , fvalues.size() * sizeof(float) );
+            std::copy( fvalues.begin() , fvalues.end() , values.begin() );
+        } else
+            m_stream.read( reinterpret_cast<char*>( values.data() ) , values.size() * sizeof(double) );
+
+        if (!m_stream)
+            OPM_THROW(std::runtime_error , "Failed reading time series file: " << m_path);
+        return values;
+    }
+
+}
@@ -0,0 +1,147 @@
+/*
+  Copyright 2016 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_TIMESERIESRECORDER_HPP
+#define OPM_TIMESERIESRECORDER_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <opm/common/data/SimulationDataContainer.hpp>
+
+namespace Opm {
+
+    /// The TimeSeriesRecorder tracks the evolution of selected parts
+    /// of a SimulationDataContainer across timesteps. A probe is a
+    /// named selection of elements from one cell data field - e.g.
+    /// the pressure in the well cells, or a handful of saturation
+    /// values - and on every recordStep() call the current values of
+    /// all probes are gathered from the container and appended to
+    /// the recorder file as one fixed width record. For monitoring
+    /// use this replaces GB-scale full state snapshots with KB-scale
+    /// appends.
+    ///
+    /// The file starts with a header describing the probes, written
+    /// when the first step is recorded; after that the probe set is
+    /// frozen. Because every step record has the same size, and each
+    /// record is written with one write() call followed by a flush,
+    /// the file can be read with TimeSeriesReader while the
+    /// simulation is still appending to it - a torn record at the
+    /// tail is simply not counted by numSteps() yet.
+    ///
+    /// Values are stored per probe in either double or float
+    /// precision; float is the default and halves the file size,
+    /// which for monitoring quantities is almost always the right
+    /// trade.
+    class TimeSeriesRecorder
+    {
+    public:
+        typedef SimulationDataContainer::Precision Precision;
+
+        /// Open (and truncate) the recorder file. The header is not
+        /// written until the first recordStep() call.
+        explicit TimeSeriesRecorder(const std::string& path);
+
+        /// Register a probe gathering the elements @indices from the
+        /// cell data field @field_name. The indices are raw indices
+        /// into the field data - for a multi component field the
+        /// caller must resolve cell and component to an index
+        /// according to the field layout. Probes can only be added
+        /// before the first recordStep() call.
+        void addProbe(const std::string& probe_name , const std::string& field_name , std::vector<size_t> indices , Precision precision = Precision::Float);
+
+        /// Gather all probes from @state and append one record with
+        /// the step counter and @time. The first call freezes the
+        /// probe set and writes the file header.
+        void recordStep(const SimulationDataContainer& state , double time);
+
+        size_t numProbes() const;
+        size_t numSteps() const;
+
+    private:
+        struct Probe {
+            std::string name;
+            std::string field;
+            std::vector<size_t> indices;
+            Precision precision;
+        };
+
+        void writeHeader();
+
+        std::string m_path;
+        std::ofstream m_stream;
+        std::vector<Probe> m_probes;
+        std::vector<char> m_record;
+        size_t m_record_size = 0;
+        size_t m_num_steps = 0;
+        bool m_frozen = false;
+    };
+
+
+    /// Read side of the TimeSeriesRecorder file format. The header
+    /// is parsed by the constructor; numSteps() re-examines the file
+    /// size on every call, so a reader polling a file which a live
+    /// simulation is appending to will see new steps as they
+    /// complete.
+    class TimeSeriesReader
+    {
+    public:
+        explicit TimeSeriesReader(const std::string& path);
+
+        size_t numProbes() const;
+        const std::string& probeName(size_t probe) const;
+        const std::string& fieldName(size_t probe) const;
+        size_t probeSize(size_t probe) const;
+
+        /// The number of complete step records currently in the
+        /// file; a partially written record at the tail is not
+        /// counted.
+        size_t numSteps();
+
+        /// The step counter / simulation time stored in record @step.
+        uint64_t stepIndex(size_t step);
+        double stepTime(size_t step);
+
+        /// The values of probe @probe in record @step; float
+        /// precision probes are widened to double.
+        std::vector<double> values(size_t step , size_t probe);
+
+    private:
+        struct ProbeInfo {
+            std::string name;
+            std::string field;
+            size_t num_values;
+            bool fvalues;
+            size_t record_offset;
+        };
+
+        void seekRecord(size_t step , size_t offset);
+
+        std::string m_path;
+        std::ifstream m_stream;
+        std::vector<ProbeInfo> m_probes;
+        size_t m_data_offset = 0;
+        size_t m_record_size = 0;
+    };
+
+}
+
+#endif
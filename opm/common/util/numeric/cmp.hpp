@@ -21,6 +21,8 @@
 #define COMMON_UTIL_NUMERIC_CMP
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 #include <type_traits>
 #include <cmath>
@@ -44,7 +46,9 @@ namespace Opm {
     /// actual comparison is based on the scalar_equal<T>()
     /// function. All functions exist as two overloads, one which
     /// takes explicit input values for the absolute and relative
-    /// epsilon, and one which uses default values.  
+    /// epsilon, and one which uses default values. In addition all
+    /// three exist in _ulp variants where the tolerance is given as
+    /// a maximum ULP distance instead of the two epsilons.
     ///
     /// The comparison functions are implemented as templates, with
     /// the following caveats:
@@ -87,23 +91,106 @@ namespace Opm {
   	    return scalar_equal<T>( value1 , value2 , default_abs_epsilon , default_rel_epsilon );
 	}
 
+        /*
+          The _ulp variants below implement the ULP-distance
+          comparison from the article referenced above: the floating
+          point values are reinterpreted as integers, the
+          sign-magnitude bit patterns mapped to a monotonically
+          increasing unsigned ordering, and two values compare equal
+          when at most max_ulps representable values lie between
+          them. The whole test is straight-line integer arithmetic
+          without fabs/max or data-dependent branches, so the array
+          loops vectorize cleanly, and the tolerance is expressed in
+          bits rather than magnitudes. Note two differences from the
+          epsilon form: the comparison is on bit patterns, so NaN is
+          never ulp-equal to a non-NaN value (but two NaN with the
+          same payload bits are equal), and values of opposite sign
+          are only equal when both are close to (plus or minus) zero.
+        */
+
+        const uint64_t default_max_ulps = 4;
+
+        namespace detail {
+            template<typename T> struct ulp_bits;
+            template<> struct ulp_bits<float>  { typedef uint32_t type; };
+            template<> struct ulp_bits<double> { typedef uint64_t type; };
+        }
+
+
         template<typename T>
-        bool vector_equal(const std::vector<T>& v1, const std::vector<T>& v2, T abs_eps, T rel_eps) {
-          if (v1.size() != v2.size()) {
-                return false;
-            }
+        uint64_t ulp_distance(T value1, T value2) {
+            static_assert(std::is_floating_point<T>::value, "Function ulp_distance() can only be instantiated with floating point types");
+            typedef typename detail::ulp_bits<T>::type U;
+            const int sign_shift = sizeof(T) * 8 - 1;
+            const U sign = U(1) << sign_shift;
+
+            U u1, u2;
+            memcpy(&u1, &value1, sizeof value1);
+            memcpy(&u2, &value2, sizeof value2);
+
+            /* Branch-free map of the sign-magnitude patterns onto a
+               monotonic unsigned ordering: positive values get the
+               sign bit added, negative values are two-complemented. */
+            U neg1 = U(0) - (u1 >> sign_shift);
+            U neg2 = U(0) - (u2 >> sign_shift);
+            u1 = (u1 ^ (neg1 | sign)) + (neg1 & 1);
+            u2 = (u2 ^ (neg2 | sign)) + (neg2 & 1);
+
+            return (u1 > u2) ? uint64_t(u1 - u2) : uint64_t(u2 - u1);
+        }
+
+
+        template<typename T>
+        bool scalar_equal_ulp(T value1, T value2, uint64_t max_ulps) {
+            return ulp_distance<T>(value1, value2) <= max_ulps;
+        }
+
+        template<typename T>
+        bool scalar_equal_ulp(T value1, T value2) {
+            return scalar_equal_ulp<T>(value1, value2, default_max_ulps);
+        }
+
 
-            for (size_t i = 0; i < v1.size(); i++) {
-                if (!scalar_equal<T>( v1[i], v2[i], abs_eps, rel_eps ))
+        template<typename T>
+        bool array_equal_ulp(const T* p1, const T* p2, size_t num_elements, uint64_t max_ulps) {
+            if (memcmp(p1 , p2 , num_elements * sizeof * p1) == 0)
+                return true;
+
+            const size_t block_size = 16;
+            size_t index = 0;
+            for (; index + block_size <= num_elements; index += block_size) {
+                int block_ok = 1;
+                for (size_t i = 0; i < block_size; i++)
+                    block_ok &= int(ulp_distance<T>(p1[index + i], p2[index + i]) <= max_ulps);
+                if (!block_ok)
                     return false;
             }
 
+            for (; index < num_elements; index++) {
+                if (!scalar_equal_ulp<T>( p1[index] , p2[index] , max_ulps))
+                    return false;
+            }
             return true;
         }
 
         template<typename T>
-        bool vector_equal(const std::vector<T>& v1, const std::vector<T>& v2) {
-            return vector_equal<T>(v1, v2, default_abs_epsilon, default_rel_epsilon);
+        bool array_equal_ulp(const T* p1, const T* p2, size_t num_elements) {
+            return array_equal_ulp<T>(p1, p2, num_elements, default_max_ulps);
+        }
+
+
+        template<typename T>
+        bool vector_equal_ulp(const std::vector<T>& v1, const std::vector<T>& v2, uint64_t max_ulps) {
+            if (v1.size() != v2.size()) {
+                return false;
+            }
+
+            return array_equal_ulp<T>( v1.data(), v2.data(), v1.size(), max_ulps );
+        }
+
+        template<typename T>
+        bool vector_equal_ulp(const std::vector<T>& v1, const std::vector<T>& v2) {
+            return vector_equal_ulp<T>(v1, v2, default_max_ulps);
         }
 
 
@@ -111,13 +198,39 @@ namespace Opm {
         bool array_equal(const T* p1, const T* p2, size_t num_elements, T abs_eps, T rel_eps) {
             if (memcmp(p1 , p2 , num_elements * sizeof * p1) == 0)
                 return true;
-            else {
-                size_t index;
-                for (index = 0; index < num_elements; index++) {
-                    if (!scalar_equal<T>( p1[index] , p2[index] , abs_eps , rel_eps)) {
-                        return false;
-                    }
+
+            /*
+              The comparison runs over blocks of elements; within one
+              block the epsilon test is evaluated branch-free as
+
+                  !(diff > abs_eps) | !(diff > scale * rel_eps)
+
+              and the per-element results are combined with a bitwise
+              and, so the compiler can vectorize the loop body across
+              SIMD lanes - the negated form gives the same result as
+              scalar_equal() also when diff is NaN. The early exit is
+              kept, but per block instead of per element, so a single
+              differing trailing element no longer costs a scalar
+              pass over the whole array.
+            */
+            const size_t block_size = 16;
+            size_t index = 0;
+            for (; index + block_size <= num_elements; index += block_size) {
+                int block_ok = 1;
+                for (size_t i = 0; i < block_size; i++) {
+                    T value1 = p1[index + i];
+                    T value2 = p2[index + i];
+                    T diff = std::fabs(value1 - value2);
+                    T scale = std::max(std::fabs(value1), std::fabs(value2));
+                    block_ok &= int(!(diff > abs_eps)) | int(!(diff > scale * rel_eps));
                 }
+                if (!block_ok)
+                    return false;
+            }
+
+            for (; index < num_elements; index++) {
+                if (!scalar_equal<T>( p1[index] , p2[index] , abs_eps , rel_eps))
+                    return false;
             }
             return true;
         }
@@ -127,6 +240,21 @@ namespace Opm {
         bool array_equal(const T* p1, const T* p2, size_t num_elements) {
              return array_equal<T>(p1, p2, num_elements , default_abs_epsilon, default_rel_epsilon);
         }
+
+
+        template<typename T>
+        bool vector_equal(const std::vector<T>& v1, const std::vector<T>& v2, T abs_eps, T rel_eps) {
+          if (v1.size() != v2.size()) {
+                return false;
+            }
+
+            return array_equal<T>( v1.data(), v2.data(), v1.size(), abs_eps, rel_eps );
+        }
+
+        template<typename T>
+        bool vector_equal(const std::vector<T>& v1, const std::vector<T>& v2) {
+            return vector_equal<T>(v1, v2, default_abs_epsilon, default_rel_epsilon);
+        }
     }
 }
 
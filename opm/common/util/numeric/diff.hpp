@@ -0,0 +1,181 @@
+/*
+  Copyright 2016 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMMON_UTIL_NUMERIC_DIFF
+#define COMMON_UTIL_NUMERIC_DIFF
+
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <opm/common/util/numeric/cmp.hpp>
+
+namespace Opm {
+
+    /// The namespace diff complements the boolean comparisons in the
+    /// cmp namespace with a structured report of *how* two arrays
+    /// differ: the largest absolute and relative deviations with
+    /// their indices, and the number and first index of the elements
+    /// failing the cmp::scalar_equal() epsilon test. The functions
+    ///
+    ///   array_diff<T>()  : compare two T * pointers.
+    ///
+    ///   vector_diff<T>() : compare two std::vector<T> instances.
+    ///
+    /// exist in overloads with explicit epsilon values and with the
+    /// cmp defaults, and take an optional thread count: with more
+    /// than one thread the arrays are partitioned statically across
+    /// a std::thread team and the per-chunk statistics merged with a
+    /// reduction, which matters when diffing multi-GB restart
+    /// vectors in a regression run.
+
+    namespace diff {
+
+        template<typename T>
+        struct Report {
+            /// Total number of elements compared.
+            size_t num_elements = 0;
+            /// Number of elements failing the epsilon test of
+            /// cmp::scalar_equal(), and the index of the first such
+            /// element; first_failure == num_elements when none fail.
+            size_t failure_count = 0;
+            size_t first_failure = 0;
+            /// The largest absolute deviation |v1 - v2| and the
+            /// largest relative deviation |v1 - v2| / max(|v1|,|v2|),
+            /// with the indices where they occur.
+            T max_abs_deviation = 0;
+            size_t max_abs_index = 0;
+            T max_rel_deviation = 0;
+            size_t max_rel_index = 0;
+
+            bool equal() const {
+                return failure_count == 0;
+            }
+        };
+
+
+        namespace detail {
+
+            template<typename T>
+            Report<T> chunk_diff(const T* p1, const T* p2, size_t begin, size_t end, T abs_eps, T rel_eps) {
+                Report<T> report;
+                report.first_failure = end;
+                for (size_t index = begin; index < end; index++) {
+                    T diff = std::fabs(p1[index] - p2[index]);
+                    T scale = std::max(std::fabs(p1[index]), std::fabs(p2[index]));
+
+                    if (diff > report.max_abs_deviation) {
+                        report.max_abs_deviation = diff;
+                        report.max_abs_index = index;
+                    }
+                    if (scale > 0 && diff / scale > report.max_rel_deviation) {
+                        report.max_rel_deviation = diff / scale;
+                        report.max_rel_index = index;
+                    }
+                    if (!cmp::scalar_equal<T>(p1[index], p2[index], abs_eps, rel_eps)) {
+                        if (report.failure_count == 0)
+                            report.first_failure = index;
+                        report.failure_count++;
+                    }
+                }
+                return report;
+            }
+
+            template<typename T>
+            void merge(Report<T>& total, const Report<T>& chunk) {
+                if (chunk.failure_count > 0 && total.failure_count == 0)
+                    total.first_failure = chunk.first_failure;
+                total.failure_count += chunk.failure_count;
+                if (chunk.max_abs_deviation > total.max_abs_deviation) {
+                    total.max_abs_deviation = chunk.max_abs_deviation;
+                    total.max_abs_index = chunk.max_abs_index;
+                }
+                if (chunk.max_rel_deviation > total.max_rel_deviation) {
+                    total.max_rel_deviation = chunk.max_rel_deviation;
+                    total.max_rel_index = chunk.max_rel_index;
+                }
+            }
+
+            // Arrays smaller than this are always diffed serially;
+            // the thread start overhead dominates below it.
+            const size_t parallel_diff_threshold = 65536;
+        }
+
+
+        template<typename T>
+        Report<T> array_diff(const T* p1, const T* p2, size_t num_elements, T abs_eps, T rel_eps, int num_threads = 1) {
+            Report<T> report;
+            report.num_elements = num_elements;
+
+            if (num_threads < 2 || num_elements < detail::parallel_diff_threshold) {
+                Report<T> chunk = detail::chunk_diff<T>(p1, p2, 0, num_elements, abs_eps, rel_eps);
+                detail::merge(report, chunk);
+                if (report.failure_count == 0)
+                    report.first_failure = num_elements;
+                return report;
+            }
+
+            // Static partition of the index range; each thread fills
+            // in its slot of the chunk report vector and the merge
+            // runs in chunk order, so first_failure stays the global
+            // first failing index.
+            std::vector<Report<T>> chunks(num_threads);
+            std::vector<std::thread> team;
+            const size_t chunk_size = num_elements / num_threads;
+            for (int t = 0; t < num_threads; t++) {
+                size_t begin = t * chunk_size;
+                size_t end = (t == num_threads - 1) ? num_elements : begin + chunk_size;
+                team.emplace_back([p1, p2, begin, end, abs_eps, rel_eps, t, &chunks] {
+                        chunks[t] = detail::chunk_diff<T>(p1, p2, begin, end, abs_eps, rel_eps);
+                    });
+            }
+            for (auto& thread : team)
+                thread.join();
+
+            for (const auto& chunk : chunks)
+                detail::merge(report, chunk);
+            if (report.failure_count == 0)
+                report.first_failure = num_elements;
+            return report;
+        }
+
+
+        template<typename T>
+        Report<T> array_diff(const T* p1, const T* p2, size_t num_elements, int num_threads = 1) {
+            return array_diff<T>(p1, p2, num_elements, T(cmp::default_abs_epsilon), T(cmp::default_rel_epsilon), num_threads);
+        }
+
+
+        template<typename T>
+        Report<T> vector_diff(const std::vector<T>& v1, const std::vector<T>& v2, T abs_eps, T rel_eps, int num_threads = 1) {
+            if (v1.size() != v2.size())
+                throw std::invalid_argument("Can not diff vectors of different size");
+
+            return array_diff<T>(v1.data(), v2.data(), v1.size(), abs_eps, rel_eps, num_threads);
+        }
+
+        template<typename T>
+        Report<T> vector_diff(const std::vector<T>& v1, const std::vector<T>& v2, int num_threads = 1) {
+            return vector_diff<T>(v1, v2, T(cmp::default_abs_epsilon), T(cmp::default_rel_epsilon), num_threads);
+        }
+    }
+}
+
+#endif
@@ -25,11 +25,16 @@
 #include <opm/common/utility/platform_dependent/reenable_warnings.h>
 
 #include <stdexcept>
+#include <cstdio>
 #include <iostream>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 
 #include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/OpmLog/AggregatingLog.hpp>
+#include <opm/common/OpmLog/BinaryLog.hpp>
 #include <opm/common/OpmLog/LogBackend.hpp>
 #include <opm/common/OpmLog/CounterLog.hpp>
 #include <opm/common/OpmLog/TimerLog.hpp>
@@ -54,6 +59,26 @@ BOOST_AUTO_TEST_CASE(Test_Format) {
 }
 
 
+BOOST_AUTO_TEST_CASE(Test_FormatTo) {
+    /* The appending formatTo() path must agree with format(), and
+       appends into the buffer it is handed. */
+    SimpleMessageFormatter formatter(true, true);
+    for (auto type : { Log::MessageType::Info , Log::MessageType::Warning , Log::MessageType::Error }) {
+        std::string buffer = "head:";
+        formatter.formatTo( type , "message" , buffer );
+        BOOST_CHECK_EQUAL( buffer , "head:" + formatter.format( type , "message" ));
+    }
+
+    std::string buffer;
+    Log::prefixMessage( Log::MessageType::Warning , "the message" , buffer );
+    BOOST_CHECK_EQUAL( buffer , "Warning: the message" );
+    BOOST_CHECK_EQUAL( Log::colorPrefix( Log::MessageType::Info ) , "" );
+    BOOST_CHECK_EQUAL( Log::colorSuffix( Log::MessageType::Info ) , "" );
+    BOOST_CHECK_EQUAL( Log::colorPrefix( Log::MessageType::Error ) + "x" + Log::colorSuffix( Log::MessageType::Error ) ,
+                       Log::colorCodeMessage( Log::MessageType::Error , "x" ));
+}
+
+
 
 BOOST_AUTO_TEST_CASE(Test_Logger) {
     Logger logger;
@@ -96,6 +121,187 @@ BOOST_AUTO_TEST_CASE(Test_Logger) {
 }
 
 
+BOOST_AUTO_TEST_CASE(Test_AsyncLogger) {
+    Logger logger;
+    std::ostringstream log_stream;
+    std::shared_ptr<CounterLog> counter = std::make_shared<CounterLog>();
+    std::shared_ptr<StreamLog> streamLog = std::make_shared<StreamLog>( log_stream , Log::MessageType::Warning );
+    logger.addBackend("COUNTER" , counter);
+    logger.addBackend("STREAM" , streamLog);
+
+    BOOST_CHECK_EQUAL( false , logger.async() );
+    logger.setAsync( 64 );
+    BOOST_CHECK_EQUAL( true , logger.async() );
+
+    /* Several producer threads hammer the small queue; after the
+       flush() barrier every message must have reached the backends. */
+    const size_t num_threads = 4;
+    const size_t messages_per_thread = 500;
+    std::vector<std::thread> producers;
+    for (size_t t = 0; t < num_threads; t++)
+        producers.emplace_back( [&logger] {
+                for (size_t i = 0; i < messages_per_thread; i++)
+                    logger.addMessage( Log::MessageType::Warning , "Warning" );
+            });
+    for (auto& thread : producers)
+        thread.join();
+
+    logger.flush();
+    BOOST_CHECK_EQUAL( num_threads * messages_per_thread , counter->numMessages(Log::MessageType::Warning) );
+
+    /* setSync() drains and joins the background thread. */
+    logger.addMessage( Log::MessageType::Error , "Error" );
+    logger.setSync();
+    BOOST_CHECK_EQUAL( false , logger.async() );
+    BOOST_CHECK_EQUAL( 1U , counter->numMessages(Log::MessageType::Error) );
+
+    logger.addMessage( Log::MessageType::Warning , "Warning" );
+    BOOST_CHECK_EQUAL( num_threads * messages_per_thread + 1 , counter->numMessages(Log::MessageType::Warning) );
+}
+
+
+BOOST_AUTO_TEST_CASE(Test_AggregatingLog) {
+    std::ostringstream log_stream;
+    auto streamLog = std::make_shared<StreamLog>( log_stream , Log::DefaultMessageTypes );
+    AggregatingLog aggLog( streamLog , Log::DefaultMessageTypes );
+
+    /* Identical records collapse into one with a count; nothing
+       reaches the sink before flush(). */
+    for (int i = 0; i < 5; i++)
+        aggLog.addMessage( Log::MessageType::Warning , "CFL violated" );
+    aggLog.addMessage( Log::MessageType::Info , "Step done" );
+    BOOST_CHECK_EQUAL( 2U , aggLog.numRecords() );
+    BOOST_CHECK( log_stream.str().empty() );
+
+    aggLog.flush();
+    BOOST_CHECK_EQUAL( log_stream.str() , "CFL violated (5 occurrences)\nStep done\n" );
+    BOOST_CHECK_EQUAL( 0U , aggLog.numRecords() );
+
+    /* pack/merge combines the records of two instances - the local
+       half of a cross-process gather. */
+    AggregatingLog otherLog( streamLog , Log::DefaultMessageTypes );
+    aggLog.addMessage( Log::MessageType::Warning , "CFL violated" );
+    otherLog.addMessage( Log::MessageType::Warning , "CFL violated" );
+    otherLog.addTaggedMessage( Log::MessageType::Warning , "W1" , "Well shut" );
+
+    aggLog.mergeRecords( otherLog.packRecords() );
+    log_stream.str("");
+    aggLog.flush();
+    BOOST_CHECK_EQUAL( log_stream.str() , "CFL violated (2 occurrences)\nWell shut\n" );
+
+    BOOST_CHECK_THROW( aggLog.mergeRecords( "garbage" ) , std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE(Test_BinaryLog) {
+    const std::string log_file = "binary.log";
+    {
+        BinaryLog binLog( log_file , Log::DefaultMessageTypes );
+        binLog.addMessage( Log::MessageType::Info , "Info" );
+        binLog.addTaggedMessage( Log::MessageType::Warning , "TAG" , "Tagged warning" );
+        binLog.addMessage( Log::MessageType::Error , "Error" );
+    }
+
+    std::ostringstream text;
+    BinaryLog::convertToText( log_file , text );
+    BOOST_CHECK_EQUAL( text.str() ,
+                       Log::prefixMessage( Log::MessageType::Info , "Info" ) + "\n" +
+                       Log::prefixMessage( Log::MessageType::Warning , "Tagged warning" ) + "\n" +
+                       Log::prefixMessage( Log::MessageType::Error , "Error" ) + "\n" );
+
+    /* Appending continues an existing file. */
+    {
+        BinaryLog binLog( log_file , Log::DefaultMessageTypes , true );
+        binLog.addMessage( Log::MessageType::Info , "More info" );
+    }
+    text.str("");
+    BinaryLog::convertToText( log_file , text );
+    BOOST_CHECK_EQUAL( text.str() ,
+                       Log::prefixMessage( Log::MessageType::Info , "Info" ) + "\n" +
+                       Log::prefixMessage( Log::MessageType::Warning , "Tagged warning" ) + "\n" +
+                       Log::prefixMessage( Log::MessageType::Error , "Error" ) + "\n" +
+                       Log::prefixMessage( Log::MessageType::Info , "More info" ) + "\n" );
+
+    BOOST_CHECK_THROW( BinaryLog::convertToText( "/no/such/file" , text ) , std::invalid_argument );
+
+    /* Custom message types have no built-in prefix and come back
+       verbatim. */
+    const int64_t custom_type = 4096;
+    {
+        BinaryLog binLog( log_file , Log::DefaultMessageTypes + custom_type );
+        binLog.addMessage( Log::MessageType::Info , "Info" );
+        binLog.addMessage( custom_type , "Custom message" );
+    }
+    text.str("");
+    BOOST_CHECK_NO_THROW( BinaryLog::convertToText( log_file , text ));
+    BOOST_CHECK_EQUAL( text.str() ,
+                       Log::prefixMessage( Log::MessageType::Info , "Info" ) + "\n" +
+                       "Custom message\n" );
+    std::remove( log_file.c_str() );
+}
+
+
+BOOST_AUTO_TEST_CASE(Test_BufferedStreamLog) {
+    std::ostringstream log_stream;
+    StreamLog streamLog( log_stream , Log::DefaultMessageTypes );
+    streamLog.setBuffering( 1024 * 1024 , 3600 );
+
+    /* Below the size threshold and within the flush interval the
+       messages stay in the internal buffer. */
+    streamLog.addMessage( Log::MessageType::Info , "Info 1" );
+    streamLog.addMessage( Log::MessageType::Info , "Info 2" );
+    BOOST_CHECK( log_stream.str().empty() );
+
+    streamLog.flush();
+    BOOST_CHECK_EQUAL( log_stream.str() , "Info 1\nInfo 2\n" );
+
+    /* Error messages match the default flush mask and go straight
+       through - together with whatever was buffered before them. */
+    streamLog.addMessage( Log::MessageType::Info , "Info 3" );
+    streamLog.addMessage( Log::MessageType::Error , "Error" );
+    BOOST_CHECK_EQUAL( log_stream.str() , "Info 1\nInfo 2\nInfo 3\nError\n" );
+
+    /* A tiny size threshold flushes on every message. */
+    streamLog.setBuffering( 1 , 3600 );
+    streamLog.addMessage( Log::MessageType::Info , "Info 4" );
+    BOOST_CHECK_EQUAL( log_stream.str() , "Info 1\nInfo 2\nInfo 3\nError\nInfo 4\n" );
+}
+
+
+BOOST_AUTO_TEST_CASE(Test_LazyMessage) {
+    Logger logger;
+    std::shared_ptr<CounterLog> counter = std::make_shared<CounterLog>( Log::MessageType::Warning );
+    logger.addBackend( "COUNTER" , counter );
+
+    /* No backend listens to Debug messages - the builder must not
+       be invoked. */
+    size_t builder_calls = 0;
+    logger.addMessage( Log::MessageType::Debug , [&builder_calls] {
+            builder_calls++;
+            return std::string("Debug");
+        });
+    BOOST_CHECK_EQUAL( 0U , builder_calls );
+
+    logger.addMessage( Log::MessageType::Warning , [&builder_calls] {
+            builder_calls++;
+            return std::string("Warning");
+        });
+    BOOST_CHECK_EQUAL( 1U , builder_calls );
+    BOOST_CHECK_EQUAL( 1U , counter->numMessages( Log::MessageType::Warning ));
+
+    logger.addTaggedMessage( Log::MessageType::Warning , "TAG" , [&builder_calls] {
+            builder_calls++;
+            return std::string("Tagged warning");
+        });
+    BOOST_CHECK_EQUAL( 2U , builder_calls );
+    BOOST_CHECK_EQUAL( 2U , counter->numMessages( Log::MessageType::Warning ));
+
+    /* Unrecognized message types must still throw - also on the
+       lazy path. */
+    BOOST_CHECK_THROW( logger.addMessage( 4096 , [] { return std::string("?"); }) , std::invalid_argument );
+}
+
+
 BOOST_AUTO_TEST_CASE(LoggerAddTypes_PowerOf2) {
     Logger logger;
     int64_t not_power_of2 = 13;
@@ -186,6 +392,40 @@ BOOST_AUTO_TEST_CASE( CounterLogTesting) {
     }
 }
 
+
+BOOST_AUTO_TEST_CASE( CounterLogEvents) {
+    CounterLog counter;
+
+    /* Per-tag event counters - also from concurrent threads. */
+    BOOST_CHECK_EQUAL( 0U , counter.numEvents("W1") );
+    const size_t num_threads = 4;
+    const size_t events_per_thread = 1000;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; t++)
+        threads.emplace_back( [&counter] {
+                for (size_t i = 0; i < events_per_thread; i++)
+                    counter.countEvent("W1");
+            });
+    for (auto& thread : threads)
+        thread.join();
+    BOOST_CHECK_EQUAL( num_threads * events_per_thread , counter.numEvents("W1") );
+    BOOST_CHECK_EQUAL( 0U , counter.numEvents("W2") );
+
+    /* Log-scale latency histogram: 1.5 us -> bucket 0, 3 us ->
+       bucket 1, ~1 ms -> bucket 9. */
+    counter.recordLatency( "solve" , 1.5e-6 );
+    counter.recordLatency( "solve" , 3e-6 );
+    counter.recordLatency( "solve" , 1.0e-3 );
+    auto histogram = counter.latencyHistogram("solve");
+    BOOST_CHECK_EQUAL( 1U , histogram[0] );
+    BOOST_CHECK_EQUAL( 1U , histogram[1] );
+    BOOST_CHECK_EQUAL( 1U , histogram[9] );
+
+    counter.clear();
+    BOOST_CHECK_EQUAL( 0U , counter.numEvents("W1") );
+    BOOST_CHECK_EQUAL( 0U , counter.latencyHistogram("solve")[0] );
+}
+
 BOOST_AUTO_TEST_CASE(TestTimerLog) {
     Logger logger;
     std::ostringstream sstream;
@@ -197,6 +437,29 @@ BOOST_AUTO_TEST_CASE(TestTimerLog) {
     logger.addMessage( TimerLog::StartTimer , "");
     logger.addMessage( TimerLog::StopTimer , "This was fast");
     std::cout << sstream.str() << std::endl;
+
+    /* Nested scoped regions aggregate per-name statistics. */
+    {
+        TimerLog::Scope outer( *timer , "outer" );
+        for (int i = 0; i < 3; i++)
+            TimerLog::Scope inner( *timer , "inner" );
+    }
+    BOOST_CHECK_EQUAL( 3U , timer->regionStats().at("inner").count );
+    BOOST_CHECK_EQUAL( 1U , timer->regionStats().at("outer").count );
+    BOOST_CHECK( timer->regionStats().at("inner").min <= timer->regionStats().at("inner").max );
+    timer->summary();
+
+    BOOST_CHECK_THROW( timer->stopRegion("nothing-active") , std::logic_error );
+    timer->clear();
+    BOOST_CHECK( timer->regionStats().empty() );
+
+    /* clear() while a Scope is live: the Scope destructor must not
+       let the stopRegion() error escape and terminate the process. */
+    {
+        TimerLog::Scope orphan( *timer , "orphan" );
+        timer->clear();
+    }
+    BOOST_CHECK( timer->regionStats().empty() );
 }
 
 
@@ -421,3 +684,81 @@ BOOST_AUTO_TEST_CASE(TestFormat)
     BOOST_CHECK_EQUAL(log_stream2.str(), expected2);
     BOOST_CHECK_EQUAL(log_stream3.str(), expected3);
 }
+
+
+/* The OPM_LOG_* macros test the category against the compile-time
+   constant OPM_LOG_COMPILETIME_MESSAGE_TYPES at the expansion point,
+   so the mask can be narrowed locally to exercise the elision. */
+#undef OPM_LOG_COMPILETIME_MESSAGE_TYPES
+#define OPM_LOG_COMPILETIME_MESSAGE_TYPES (::Opm::Log::DefaultMessageTypes & ~(::Opm::Log::MessageType::Debug | ::Opm::Log::MessageType::Note))
+
+BOOST_AUTO_TEST_CASE(TestCompiletimeElision)
+{
+    OpmLog::removeAllBackends();
+    std::ostringstream log_stream;
+    OpmLog::addBackend("STREAM" , std::make_shared<StreamLog>( log_stream , Log::DefaultMessageTypes ));
+
+    int invocations = 0;
+    auto builder = [&invocations]() { invocations++; return std::string("Elided"); };
+
+    /* Debug and Note are excluded from the compile-time mask: the
+       statements compile, but the message argument is never
+       evaluated and nothing reaches the backend. */
+    OPM_LOG_DEBUG( "Elided" );
+    OPM_LOG_NOTE( "Elided" );
+    OPM_LOG_DEBUG( builder );
+    BOOST_CHECK_EQUAL( invocations , 0 );
+
+    /* The remaining categories behave exactly like the OpmLog
+       functions, including the lazy builder overloads and the
+       runtime mask. */
+    OPM_LOG_WARNING( "Warning" );
+    OPM_LOG_INFO( builder );
+    OPM_LOG_TAGGED_MESSAGE( Log::MessageType::Error , "TAG" , "Error" );
+    BOOST_CHECK_EQUAL( invocations , 1 );
+    BOOST_CHECK_EQUAL( log_stream.str() , "Warning\nElided\nError\n" );
+
+    OpmLog::removeAllBackends();
+}
+
+#undef OPM_LOG_COMPILETIME_MESSAGE_TYPES
+#define OPM_LOG_COMPILETIME_MESSAGE_TYPES ::Opm::Log::DefaultMessageTypes
+
+
+BOOST_AUTO_TEST_CASE(TestCompressedStreamLog) {
+    const std::string log_file = "/tmp/compressed_log.gz";
+    {
+        StreamLog log( log_file , Log::DefaultMessageTypes , false , true );
+        log.addMessage( Log::MessageType::Info , "Message 1" );
+        log.addMessage( Log::MessageType::Info , "Message 2" );
+
+        /* Unbuffered messages each end on a frame boundary, so the
+           file can be followed while the backend still has it open. */
+        BOOST_CHECK_EQUAL( StreamLog::readCompressed( log_file ) , "Message 1\nMessage 2\n" );
+
+        /* With buffering one frame covers everything up to the next
+           flush point; until then a live reader sees the old tail. */
+        log.setBuffering( 1024 * 1024 , 3600 );
+        log.addMessage( Log::MessageType::Info , "Message 3" );
+        BOOST_CHECK_EQUAL( StreamLog::readCompressed( log_file ) , "Message 1\nMessage 2\n" );
+        log.flush();
+        BOOST_CHECK_EQUAL( StreamLog::readCompressed( log_file ) , "Message 1\nMessage 2\nMessage 3\n" );
+    }
+
+    /* Appending to a compressed log starts a new gzip member, which
+       the reader concatenates transparently. */
+    {
+        StreamLog log( log_file , Log::DefaultMessageTypes , true , true );
+        log.addMessage( Log::MessageType::Info , "Message 4" );
+    }
+    BOOST_CHECK_EQUAL( StreamLog::readCompressed( log_file ) , "Message 1\nMessage 2\nMessage 3\nMessage 4\n" );
+    std::remove( log_file.c_str() );
+
+    {
+        std::ofstream stream( "/tmp/plain_log.txt" );
+        stream << "Not compressed" << std::endl;
+    }
+    BOOST_CHECK_THROW( StreamLog::readCompressed( "/tmp/plain_log.txt" ) , std::runtime_error );
+    BOOST_CHECK_THROW( StreamLog::readCompressed( "/file/does/not/exist" ) , std::runtime_error );
+    std::remove( "/tmp/plain_log.txt" );
+}
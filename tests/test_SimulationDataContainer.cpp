@@ -22,6 +22,9 @@
 #define BOOST_TEST_MODULE SIMULATION_DATA_CONTAINER_TESTS
 #include <boost/test/unit_test.hpp>
 
+#include <cstdio>
+#include <fstream>
+#include <iterator>
 #include <stdexcept>
 #include <iostream>
 #include <opm/common/data/SimulationDataContainer.hpp>
@@ -115,6 +118,416 @@ BOOST_AUTO_TEST_CASE(TestRegisterCellData) {
 }
 
 
+BOOST_AUTO_TEST_CASE(TestFieldHandle) {
+    SimulationDataContainer container(100 , 10 , 2);
+
+    BOOST_CHECK_THROW( container.getCellDataHandle("FIELDX") , std::invalid_argument );
+    auto handle = container.registerCellData("FIELDX" , 1 , 123 );
+    BOOST_CHECK_EQUAL( handle , container.getCellDataHandle("FIELDX") );
+
+    // Registering the same field again must return the same handle.
+    BOOST_CHECK_EQUAL( handle , container.registerCellData("FIELDX" , 1 , 123 ));
+
+    {
+        auto& fieldx = container.getCellData( handle );
+        BOOST_CHECK_EQUAL( fieldx.size() , 100U );
+        BOOST_CHECK_EQUAL( fieldx[0] , 123 );
+        fieldx[0] = 456;
+    }
+    BOOST_CHECK_EQUAL( container.getCellData("FIELDX")[0] , 456 );
+
+    // The default fields should also be reachable through handles.
+    auto pressure_handle = container.getCellDataHandle("PRESSURE");
+    BOOST_CHECK_EQUAL( &container.getCellData( pressure_handle ) , &container.pressure() );
+
+    auto flux_handle = container.registerFaceData("FLUX" , 1 , 99 );
+    BOOST_CHECK_EQUAL( flux_handle , container.getFaceDataHandle("FLUX"));
+    BOOST_CHECK_EQUAL( container.getFaceData( flux_handle )[0] , 99 );
+
+    // Handles must survive copying and swapping.
+    SimulationDataContainer copy( container );
+    BOOST_CHECK_EQUAL( copy.getCellData( handle )[0] , 456 );
+    copy.getCellData( handle )[0] = 789;
+    BOOST_CHECK_EQUAL( container.getCellData( handle )[0] , 456 );
+
+    container.swap( copy );
+    BOOST_CHECK_EQUAL( container.getCellData( handle )[0] , 789 );
+    BOOST_CHECK_EQUAL( copy.getCellData( handle )[0] , 456 );
+}
+
+
+BOOST_AUTO_TEST_CASE(TestContiguousStorage) {
+    SimulationDataContainer container(100 , 10 , 2 , SimulationDataContainer::Storage::Contiguous );
+    BOOST_CHECK( container.storage() == SimulationDataContainer::Storage::Contiguous );
+
+    // The vector reference accessors can not be used in contiguous mode.
+    BOOST_CHECK_THROW( container.getCellData("PRESSURE") , std::logic_error );
+    auto pressure_handle = container.getCellDataHandle("PRESSURE");
+    BOOST_CHECK_THROW( container.getCellData( pressure_handle ) , std::logic_error );
+
+    auto handle = container.registerCellData("FIELDX" , 2 , 123 );
+    BOOST_CHECK_EQUAL( container.numCellDataComponents("FIELDX") , 2U );
+    {
+        auto fieldx = container.cellDataView( handle );
+        BOOST_CHECK_EQUAL( fieldx.size , 200U );
+        for (auto v : fieldx)
+            BOOST_CHECK_EQUAL( v , 123 );
+        // Each field must start on a 64 byte boundary within the arena.
+        BOOST_CHECK_EQUAL( size_t(fieldx.data - container.cellDataView( pressure_handle ).data) % 8 , 0U );
+        fieldx[0] = 456;
+    }
+    BOOST_CHECK_EQUAL( container.cellDataView("FIELDX")[0] , 456 );
+
+    // equal() must work across storage modes.
+    SimulationDataContainer individual(100 , 10 , 2 );
+    individual.registerCellData("FIELDX" , 2 , 123 );
+    BOOST_CHECK( !container.equal( individual ));
+    individual.getCellData("FIELDX")[0] = 456;
+    BOOST_CHECK( container.equal( individual ));
+
+    // Copies of contiguous containers must be independent.
+    SimulationDataContainer copy( container );
+    copy.cellDataView( handle )[0] = 789;
+    BOOST_CHECK_EQUAL( container.cellDataView( handle )[0] , 456 );
+    BOOST_CHECK_EQUAL( copy.cellDataView( handle )[0] , 789 );
+}
+
+
+BOOST_AUTO_TEST_CASE(TestComponentLayout) {
+    SimulationDataContainer container(4 , 2 , 3);
+    container.registerCellData("CM" , 3 , SimulationDataContainer::Layout::ComponentMajor , 0 );
+    BOOST_CHECK( container.cellDataLayout("CM") == SimulationDataContainer::Layout::ComponentMajor );
+    BOOST_CHECK( container.cellDataLayout("SATURATION") == SimulationDataContainer::Layout::CellMajor );
+
+    // Fill each component with a recognizable pattern through the
+    // strided views and verify the underlying layouts.
+    for (size_t component = 0; component < 3; component++) {
+        auto cm = container.cellDataComponent("CM" , component );
+        auto sat = container.cellDataComponent("SATURATION" , component );
+        BOOST_CHECK_EQUAL( cm.stride , 1U );
+        BOOST_CHECK_EQUAL( sat.stride , 3U );
+        for (size_t cell = 0; cell < 4; cell++) {
+            cm[cell] = 10.0*component + cell;
+            sat[cell] = 10.0*component + cell;
+        }
+    }
+
+    {
+        auto cm = container.cellDataView("CM");
+        auto sat = container.cellDataView("SATURATION");
+        BOOST_CHECK_EQUAL( cm[0*4 + 2] , 2 );     // component 0 , cell 2
+        BOOST_CHECK_EQUAL( cm[2*4 + 1] , 21 );    // component 2 , cell 1
+        BOOST_CHECK_EQUAL( sat[2*3 + 0] , 2 );    // cell 2 , component 0
+        BOOST_CHECK_EQUAL( sat[1*3 + 2] , 21 );   // cell 1 , component 2
+    }
+
+    // Conversion must preserve the component/cell values.
+    container.convertCellDataLayout("CM" , SimulationDataContainer::Layout::CellMajor );
+    BOOST_CHECK( container.cellDataLayout("CM") == SimulationDataContainer::Layout::CellMajor );
+    {
+        auto cm = container.cellDataView("CM");
+        auto sat = container.cellDataView("SATURATION");
+        for (size_t i = 0; i < cm.size; i++)
+            BOOST_CHECK_EQUAL( cm[i] , sat[i] );
+    }
+
+    BOOST_CHECK_THROW( container.cellDataComponent("CM" , 3) , std::invalid_argument );
+
+    // setCellDataComponent must respect the layout.
+    container.convertCellDataLayout("CM" , SimulationDataContainer::Layout::ComponentMajor );
+    container.setCellDataComponent("CM" , 1 , {0,3} , {100,103} );
+    BOOST_CHECK_EQUAL( container.cellDataComponent("CM",1)[0] , 100 );
+    BOOST_CHECK_EQUAL( container.cellDataComponent("CM",1)[3] , 103 );
+}
+
+
+BOOST_AUTO_TEST_CASE(TestCopyOnWrite) {
+    SimulationDataContainer state(100 , 10 , 2);
+    state.registerCellData("FIELDX" , 1 , 123 );
+    state.pressure()[0] = 1.0;
+
+    const SimulationDataContainer& const_state = state;
+    SimulationDataContainer snapshot( state );
+    const SimulationDataContainer& const_snapshot = snapshot;
+
+    // The copy shares the field buffers with the source.
+    BOOST_CHECK_EQUAL( const_state.cellDataView("FIELDX").data , const_snapshot.cellDataView("FIELDX").data );
+    BOOST_CHECK_EQUAL( &const_state.pressure() , &const_snapshot.pressure() );
+
+    // Mutable access to one field detaches that field only.
+    state.getCellData("FIELDX")[0] = 456;
+    BOOST_CHECK( const_state.cellDataView("FIELDX").data != const_snapshot.cellDataView("FIELDX").data );
+    BOOST_CHECK_EQUAL( &const_state.pressure() , &const_snapshot.pressure() );
+
+    BOOST_CHECK_EQUAL( const_snapshot.cellDataView("FIELDX")[0] , 123 );
+    BOOST_CHECK_EQUAL( const_state.cellDataView("FIELDX")[0] , 456 );
+
+    // Rollback by assignment shares again.
+    state = snapshot;
+    BOOST_CHECK_EQUAL( const_state.cellDataView("FIELDX")[0] , 123 );
+    BOOST_CHECK_EQUAL( const_state.cellDataView("FIELDX").data , const_snapshot.cellDataView("FIELDX").data );
+
+    // Writing through the snapshot must not leak into the state.
+    snapshot.pressure()[0] = 99;
+    BOOST_CHECK_EQUAL( const_state.pressure()[0] , 1.0 );
+}
+
+
+BOOST_AUTO_TEST_CASE(TestMove) {
+    SimulationDataContainer container(100 , 10 , 2);
+
+    // Adopting a precomputed vector must not copy the data.
+    std::vector<double> initial_pressure(100 , 50.0);
+    const double* buffer = initial_pressure.data();
+    auto handle = container.registerCellData("P_INIT" , 1 , std::move(initial_pressure));
+    BOOST_CHECK_EQUAL( container.getCellData( handle ).data() , buffer );
+    BOOST_CHECK_EQUAL( container.getCellData( handle )[99] , 50.0 );
+
+    std::vector<double> wrong_size(50 , 0.0);
+    BOOST_CHECK_THROW( container.registerCellData("WRONG" , 1 , std::move(wrong_size)) , std::invalid_argument );
+
+    // Moving the container must hand over the buffers.
+    SimulationDataContainer moved( std::move(container) );
+    BOOST_CHECK_EQUAL( moved.getCellData( handle ).data() , buffer );
+    BOOST_CHECK_EQUAL( moved.numCells() , 100U );
+
+    SimulationDataContainer assigned(1 , 1 , 1);
+    assigned = std::move( moved );
+    BOOST_CHECK_EQUAL( assigned.getCellData( handle ).data() , buffer );
+    BOOST_CHECK_EQUAL( assigned.numPhases() , 2U );
+}
+
+
+BOOST_AUTO_TEST_CASE(TestParallelInitialization) {
+    BOOST_CHECK_EQUAL( SimulationDataContainer::initializationThreads() , 1 );
+    SimulationDataContainer::setInitializationThreads( 4 );
+    BOOST_CHECK_EQUAL( SimulationDataContainer::initializationThreads() , 4 );
+
+    {
+        SimulationDataContainer individual(100000 , 10 , 2);
+        individual.registerCellData("FIELDX" , 2 , 3.14 );
+        for (auto v : individual.getCellData("FIELDX"))
+            BOOST_CHECK_EQUAL( v , 3.14 );
+
+        SimulationDataContainer contiguous(100000 , 10 , 2 , SimulationDataContainer::Storage::Contiguous );
+        contiguous.registerCellData("FIELDX" , 2 , 3.14 );
+        for (auto v : contiguous.cellDataView("FIELDX"))
+            BOOST_CHECK_EQUAL( v , 3.14 );
+
+        BOOST_CHECK( individual.equal( contiguous ));
+    }
+
+    SimulationDataContainer::setInitializationThreads( 1 );
+}
+
+
+BOOST_AUTO_TEST_CASE(TestMixedPrecision) {
+    SimulationDataContainer container(100 , 10 , 2);
+    auto handle = container.registerCellData("TRACER" , 1 , SimulationDataContainer::Precision::Float , 0.25 );
+
+    BOOST_CHECK( container.cellDataPrecision("TRACER") == SimulationDataContainer::Precision::Float );
+    BOOST_CHECK( container.cellDataPrecision("PRESSURE") == SimulationDataContainer::Precision::Double );
+
+    // The double accessors must refuse float fields and vice versa.
+    BOOST_CHECK_THROW( container.getCellData("TRACER") , std::logic_error );
+    BOOST_CHECK_THROW( container.cellDataView("TRACER") , std::logic_error );
+    BOOST_CHECK_THROW( container.getCellDataFloat("PRESSURE") , std::logic_error );
+
+    auto& tracer = container.getCellDataFloat( handle );
+    BOOST_CHECK_EQUAL( tracer.size() , 100U );
+    BOOST_CHECK_EQUAL( tracer[0] , 0.25f );
+    tracer[0] = 0.5f;
+
+    // The converting accessor works for both precisions.
+    BOOST_CHECK_EQUAL( container.cellDataAsDouble("TRACER")[0] , 0.5 );
+    BOOST_CHECK_EQUAL( container.cellDataAsDouble("PRESSURE").size() , 100U );
+
+    // Registering with Precision::Double is the plain registration.
+    container.registerCellData("FIELDX" , 1 , SimulationDataContainer::Precision::Double , 123 );
+    BOOST_CHECK_EQUAL( container.getCellData("FIELDX")[0] , 123 );
+
+    // Copy-on-write and equal() must handle float fields too.
+    SimulationDataContainer copy( container );
+    copy.getCellDataFloat( handle )[0] = 0.75f;
+    BOOST_CHECK_EQUAL( container.getCellDataFloat( handle )[0] , 0.5f );
+    BOOST_CHECK( !container.equal( copy ));
+    copy.getCellDataFloat( handle )[0] = 0.5f;
+    BOOST_CHECK( container.equal( copy ));
+}
+
+
+BOOST_AUTO_TEST_CASE(TestDirtyTracking) {
+    SimulationDataContainer container(100 , 10 , 2);
+    auto handle = container.registerCellData("FIELDX" , 1 , 123 );
+
+    // Newly registered fields start out dirty.
+    BOOST_CHECK( container.cellDataDirty("FIELDX") );
+    BOOST_CHECK( container.cellDataDirty("PRESSURE") );
+    BOOST_CHECK( container.faceDataDirty("FACEFLUX") );
+    BOOST_CHECK_EQUAL( container.dirtyCellData().size() , 4U );
+
+    container.markAllClean();
+    BOOST_CHECK( !container.cellDataDirty( handle ));
+    BOOST_CHECK( container.dirtyCellData().empty() );
+    BOOST_CHECK( container.dirtyFaceData().empty() );
+
+    // Only the fields accessed mutably become dirty again.
+    container.pressure()[0] = 1.0;
+    container.getCellData( handle )[0] = 456;
+    container.getFaceData("FACEFLUX")[0] = 2.0;
+    BOOST_CHECK( container.cellDataDirty("PRESSURE") );
+    BOOST_CHECK( !container.cellDataDirty("SATURATION") );
+    BOOST_CHECK( container.faceDataDirty("FACEFLUX") );
+    BOOST_CHECK( !container.faceDataDirty("FACEPRESSURE") );
+    {
+        const auto dirty = container.dirtyCellData();
+        BOOST_REQUIRE_EQUAL( dirty.size() , 2U );
+        BOOST_CHECK_EQUAL( dirty[0] , "PRESSURE" );
+        BOOST_CHECK_EQUAL( dirty[1] , "FIELDX" );
+    }
+
+    // Const access does not mark anything dirty.
+    container.markCellDataClean("PRESSURE");
+    const SimulationDataContainer& const_container = container;
+    BOOST_CHECK_EQUAL( const_container.pressure()[0] , 1.0 );
+    BOOST_CHECK( !container.cellDataDirty("PRESSURE") );
+
+    // The mutable views count as modifications too.
+    container.cellDataView("PRESSURE");
+    BOOST_CHECK( container.cellDataDirty("PRESSURE") );
+}
+
+
+BOOST_AUTO_TEST_CASE(TestCellSubView) {
+    SimulationDataContainer container(100 , 10 , 2);
+    auto pressure = container.getCellDataHandle("PRESSURE");
+    auto saturation = container.getCellDataHandle("SATURATION");
+    for (size_t cell = 0; cell < 100; cell++) {
+        container.pressure()[cell] = cell;
+        container.saturation()[cell*2] = 10.0 + cell;
+        container.saturation()[cell*2 + 1] = 20.0 + cell;
+    }
+
+    BOOST_CHECK_THROW( container.cellSubView( 90 , 20 ) , std::invalid_argument );
+    BOOST_CHECK_THROW( container.cellSubView( 0 , 50 , {100} ) , std::invalid_argument );
+
+    auto view = container.cellSubView( 25 , 50 , {0 , 99} );
+    BOOST_CHECK_EQUAL( view.firstCell() , 25U );
+    BOOST_CHECK_EQUAL( view.numLocalCells() , 50U );
+    BOOST_CHECK_EQUAL( view.numGhostCells() , 2U );
+
+    // The local range aliases the parent's memory.
+    auto local = view.localData( pressure );
+    BOOST_CHECK_EQUAL( local.size , 50U );
+    BOOST_CHECK_EQUAL( local[0] , 25 );
+    local[0] = -1;
+    BOOST_CHECK_EQUAL( container.pressure()[25] , -1 );
+
+    auto sat1 = view.localComponent( saturation , 1 );
+    BOOST_CHECK_EQUAL( sat1[0] , 20.0 + 25 );
+    BOOST_CHECK_EQUAL( sat1[49] , 20.0 + 74 );
+
+    // Ghost cells are copies, refreshed on demand.
+    auto ghost = view.ghostData( saturation );
+    BOOST_CHECK_EQUAL( ghost.size , 4U );
+    BOOST_CHECK_EQUAL( ghost[0] , 10.0 );           // cell 0 , component 0
+    BOOST_CHECK_EQUAL( ghost[3] , 20.0 + 99 );      // cell 99 , component 1
+    container.saturation()[0] = 1000;
+    BOOST_CHECK_EQUAL( view.ghostData( saturation )[0] , 10.0 );
+    view.updateGhostCells();
+    BOOST_CHECK_EQUAL( view.ghostData( saturation )[0] , 1000 );
+
+    // Component major multi component fields have no contiguous
+    // local slice.
+    auto cm = container.registerCellData("CM" , 2 , SimulationDataContainer::Layout::ComponentMajor , 0 );
+    auto cm_view = container.cellSubView( 0 , 50 );
+    BOOST_CHECK_THROW( cm_view.localData( cm ) , std::logic_error );
+    BOOST_CHECK_EQUAL( cm_view.localComponent( cm , 1 ).stride , 1U );
+}
+
+
+BOOST_AUTO_TEST_CASE(TestFingerprint) {
+    SimulationDataContainer container1(100 , 10 , 2);
+    SimulationDataContainer container2(100 , 10 , 2);
+    BOOST_CHECK_EQUAL( container1.fingerprint() , container2.fingerprint() );
+    BOOST_CHECK_EQUAL( container1.cellDataFingerprint("PRESSURE") , container2.cellDataFingerprint("PRESSURE") );
+
+    // A cached fingerprint must be invalidated by mutable access.
+    container1.pressure()[0] = 1.0;
+    BOOST_CHECK( container1.cellDataFingerprint("PRESSURE") != container2.cellDataFingerprint("PRESSURE") );
+    BOOST_CHECK( container1.fingerprint() != container2.fingerprint() );
+    BOOST_CHECK( container1.cellDataFingerprint("SATURATION") == container2.cellDataFingerprint("SATURATION") );
+
+    container2.pressure()[0] = 1.0;
+    BOOST_CHECK_EQUAL( container1.fingerprint() , container2.fingerprint() );
+
+    container1.getFaceData("FACEFLUX")[3] = 2.0;
+    BOOST_CHECK( container1.faceDataFingerprint("FACEFLUX") != container2.faceDataFingerprint("FACEFLUX") );
+
+    // The container fingerprint covers the field names as well.
+    container1.registerCellData("FIELD1" , 1 , 0 );
+    container2.registerCellData("FIELD2" , 1 , 0 );
+    BOOST_CHECK( container1.fingerprint() != container2.fingerprint() );
+
+    // The fingerprint must agree across storage modes and survive
+    // copies which are never written through.
+    SimulationDataContainer contiguous(100 , 10 , 2 , SimulationDataContainer::Storage::Contiguous );
+    SimulationDataContainer individual(100 , 10 , 2);
+    BOOST_CHECK_EQUAL( contiguous.fingerprint() , individual.fingerprint() );
+
+    SimulationDataContainer copy( container1 );
+    BOOST_CHECK_EQUAL( copy.fingerprint() , container1.fingerprint() );
+}
+
+
+BOOST_AUTO_TEST_CASE(TestSaveLoad) {
+    const std::string path = "sdc_checkpoint.bin";
+    BOOST_CHECK_THROW( SimulationDataContainer::load("/does/not/exist") , std::runtime_error );
+
+    SimulationDataContainer state(1000 , 10 , 2);
+    state.registerCellData("FIELDX" , 2 , SimulationDataContainer::Layout::ComponentMajor , 123 );
+    state.registerCellData("TRACER" , 1 , SimulationDataContainer::Precision::Float , 0.25 );
+    state.registerFaceData("FLUX" , 1 , 99 );
+    state.pressure()[500] = 3.14;
+    state.save( path );
+
+    {
+        SimulationDataContainer restored = SimulationDataContainer::load( path );
+        BOOST_CHECK( restored.storage() == SimulationDataContainer::Storage::Contiguous );
+        BOOST_CHECK( restored.equal( state ));
+        BOOST_CHECK( restored.cellDataLayout("FIELDX") == SimulationDataContainer::Layout::ComponentMajor );
+        BOOST_CHECK_EQUAL( restored.numCellDataComponents("FIELDX") , 2U );
+        BOOST_CHECK_EQUAL( restored.getFaceData("FLUX")[0] , 99 );
+        BOOST_CHECK( restored.cellDataPrecision("TRACER") == SimulationDataContainer::Precision::Float );
+        BOOST_CHECK_EQUAL( restored.getCellDataFloat("TRACER")[999] , 0.25f );
+
+        // The mapping is private; writing to a restored container
+        // must not modify the file.
+        restored.cellDataView("PRESSURE")[500] = 1000;
+        restored.registerCellData("EXTRA" , 1 , 1 );
+    }
+
+    SimulationDataContainer again = SimulationDataContainer::load( path );
+    BOOST_CHECK_EQUAL( again.cellDataView("PRESSURE")[500] , 3.14 );
+    BOOST_CHECK( !again.hasCellData("EXTRA") );
+    BOOST_CHECK( again.equal( state ));
+
+    // A corrupt header - e.g. an absurd name length - must throw,
+    // not walk off the end of the mapping.
+    {
+        std::ifstream in( path.c_str() , std::ifstream::binary );
+        std::string bytes( (std::istreambuf_iterator<char>( in )) , std::istreambuf_iterator<char>() );
+        for (size_t i = 8 + 7 * 8; i < 8 + 8 * 8; i++)
+            bytes[i] = char( 0xff );
+        std::ofstream out( path.c_str() , std::ofstream::binary | std::ofstream::trunc );
+        out.write( bytes.data() , bytes.size() );
+    }
+    BOOST_CHECK_THROW( SimulationDataContainer::load( path ) , std::runtime_error );
+
+    std::remove( path.c_str() );
+}
+
+
 BOOST_AUTO_TEST_CASE(Test_Equal) {
     {
         SimulationDataContainer container1(100 , 10 , 2);
@@ -173,6 +586,24 @@ BOOST_AUTO_TEST_CASE(Test_Equal) {
         f[0] *= 1.1;
         BOOST_CHECK( !container1.equal( container2 ));
     }
+
+    {
+        // The component layout of a multi component field is part of
+        // the container structure: the same values in different
+        // layouts compare unequal. For single component fields the
+        // layout does not affect the storage and is ignored.
+        SimulationDataContainer container1(100 , 10 , 2);
+        SimulationDataContainer container2(100 , 10 , 2);
+
+        container1.registerCellData( "FIELDX" , 2 , SimulationDataContainer::Layout::CellMajor , 123 );
+        container2.registerCellData( "FIELDX" , 2 , SimulationDataContainer::Layout::ComponentMajor , 123 );
+        BOOST_CHECK( !container1.equal( container2 ));
+
+        container1.registerCellData( "FIELDY" , 1 , SimulationDataContainer::Layout::CellMajor , 1 );
+        container2.registerCellData( "FIELDY" , 1 , SimulationDataContainer::Layout::ComponentMajor , 1 );
+        container2.convertCellDataLayout( "FIELDX" , SimulationDataContainer::Layout::CellMajor );
+        BOOST_CHECK( container1.equal( container2 ));
+    }
 }
 
 
@@ -205,3 +636,88 @@ BOOST_AUTO_TEST_CASE(TestSetComponent) {
     BOOST_CHECK_EQUAL( data[3*2] , 40 );
 
 }
+
+
+BOOST_AUTO_TEST_CASE(TestApplyUpdates) {
+    typedef SimulationDataContainer::ComponentUpdate ComponentUpdate;
+    SimulationDataContainer container(100 , 10 , 2);
+    auto fieldx = container.registerCellData("FIELDX" , 2 , 0 );
+    auto fieldy = container.registerCellData("FIELDY" , 1 , SimulationDataContainer::Layout::ComponentMajor , 0 );
+
+    // One call updating both fields: an indexed scatter into FIELDX
+    // and a contiguous range into FIELDY.
+    std::vector<int> cells = {1,2,3};
+    std::vector<double> values0 = {20,30,40};
+    std::vector<double> range_values = {5,6,7,8};
+    container.applyCellDataUpdates( { ComponentUpdate{ fieldx , 0 , cells.data() , 0 , values0.data() , cells.size() },
+                                      ComponentUpdate{ fieldy , 0 , nullptr , 10 , range_values.data() , range_values.size() } } );
+
+    BOOST_CHECK_EQUAL( container.getCellData( fieldx )[1*2] , 20 );
+    BOOST_CHECK_EQUAL( container.getCellData( fieldx )[3*2] , 40 );
+    for (size_t i = 0; i < range_values.size(); i++)
+        BOOST_CHECK_EQUAL( container.cellDataComponent( fieldy , 0 )[10 + i] , range_values[i] );
+
+    // A failing batch must leave the container untouched.
+    std::vector<int> bad_cells = {0,100};
+    std::vector<double> bad_values = {1,2};
+    BOOST_CHECK_THROW( container.applyCellDataUpdates( { ComponentUpdate{ fieldx , 0 , bad_cells.data() , 0 , bad_values.data() , bad_cells.size() } } ),
+                       std::invalid_argument );
+    BOOST_CHECK_EQUAL( container.getCellData( fieldx )[0] , 0 );
+    BOOST_CHECK_THROW( container.applyCellDataUpdates( { ComponentUpdate{ fieldx , 2 , cells.data() , 0 , values0.data() , cells.size() } } ),
+                       std::invalid_argument );
+    BOOST_CHECK_THROW( container.applyCellDataUpdates( { ComponentUpdate{ fieldy , 0 , nullptr , 98 , values0.data() , values0.size() } } ),
+                       std::invalid_argument );
+
+    // Invalid handles and float precision fields are rejected in the
+    // validation pass, before any update in the batch is applied.
+    auto fieldf = container.registerCellData("FIELDF" , 1 , SimulationDataContainer::Precision::Float , 0 );
+    std::vector<double> other_values = {99,99,99};
+    BOOST_CHECK_THROW( container.applyCellDataUpdates( { ComponentUpdate{ fieldx , 0 , cells.data() , 0 , other_values.data() , cells.size() },
+                                                         ComponentUpdate{ fieldf , 0 , cells.data() , 0 , other_values.data() , cells.size() } } ),
+                       std::invalid_argument );
+    BOOST_CHECK_EQUAL( container.getCellData( fieldx )[1*2] , 20 );
+    BOOST_CHECK_THROW( container.applyCellDataUpdates( { ComponentUpdate{ 1000 , 0 , cells.data() , 0 , values0.data() , cells.size() } } ),
+                       std::invalid_argument );
+
+    // A contiguous range update of a cell major field uses the
+    // strided fallback.
+    container.applyCellDataUpdates( { ComponentUpdate{ fieldx , 1 , nullptr , 0 , values0.data() , values0.size() } } );
+    BOOST_CHECK_EQUAL( container.getCellData( fieldx )[0*2 + 1] , 20 );
+    BOOST_CHECK_EQUAL( container.getCellData( fieldx )[2*2 + 1] , 40 );
+}
+
+
+BOOST_AUTO_TEST_CASE(TestParallelEqual) {
+    // Large enough that the parallel path actually engages, with a
+    // float field mixed in.
+    SimulationDataContainer state(100000 , 1000 , 2);
+    state.registerCellData( "TRACER" , 1 , 1.0 );
+    state.registerCellData( "CONC" , 1 , SimulationDataContainer::Precision::Float , 0.25 );
+    state.registerFaceData( "FLUX" , 1 , 0.5 );
+
+    SimulationDataContainer copy( state );
+    BOOST_CHECK( state.equal( copy ));
+    BOOST_CHECK( state.equal( copy , 4 ));
+
+    // A difference in the last chunk of a field.
+    copy.getCellData( "TRACER" )[99999] = 2.0;
+    BOOST_CHECK( !state.equal( copy ));
+    BOOST_CHECK( !state.equal( copy , 4 ));
+    copy.getCellData( "TRACER" )[99999] = 1.0;
+
+    // ... in a float field ...
+    copy.getCellDataFloat( "CONC" )[500] = 0.75;
+    BOOST_CHECK( !state.equal( copy , 4 ));
+    copy.getCellDataFloat( "CONC" )[500] = 0.25;
+
+    // ... and in a face field.
+    copy.getFaceData( "FLUX" )[0] = 0.75;
+    BOOST_CHECK( !state.equal( copy , 4 ));
+    copy.getFaceData( "FLUX" )[0] = 0.5;
+    BOOST_CHECK( state.equal( copy , 4 ));
+
+    // Structural differences are rejected before any field data is
+    // compared, in the parallel overload too.
+    SimulationDataContainer small(100 , 10 , 2);
+    BOOST_CHECK( !state.equal( small , 4 ));
+}
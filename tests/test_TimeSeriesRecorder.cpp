@@ -0,0 +1,107 @@
+/*
+  Copyright 2016 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE TIME_SERIES_RECORDER_TESTS
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <stdexcept>
+#include <opm/common/data/TimeSeriesRecorder.hpp>
+
+using namespace Opm;
+
+
+BOOST_AUTO_TEST_CASE(TestRecordAndRead) {
+    const std::string path = "/tmp/timeseries1.bin";
+    SimulationDataContainer state(100 , 10 , 2);
+    state.registerCellData( "TRACER" , 1 , 100.0 );
+    state.registerCellData( "SAT" , 2 , 0.5 );
+
+    {
+        TimeSeriesRecorder recorder( path );
+        recorder.addProbe( "WELL_PRESSURE" , "TRACER" , { 10 , 20 , 30 } , TimeSeriesRecorder::Precision::Double );
+        recorder.addProbe( "SAT_PROBE" , "SAT" , { 0 , 1 } );
+        BOOST_CHECK_EQUAL( recorder.numProbes() , 2U );
+
+        BOOST_CHECK_THROW( recorder.addProbe( "WELL_PRESSURE" , "TRACER" , { 0 } ) , std::invalid_argument );
+        BOOST_CHECK_THROW( recorder.addProbe( "EMPTY" , "PRESSURE" , {} ) , std::invalid_argument );
+
+        for (size_t step = 0; step < 5; step++) {
+            state.getCellData( "TRACER" )[20] = 100.0 + step;
+            recorder.recordStep( state , 0.1 * step );
+        }
+        BOOST_CHECK_EQUAL( recorder.numSteps() , 5U );
+
+        /* The probe set is frozen by the first recorded step. */
+        BOOST_CHECK_THROW( recorder.addProbe( "LATE" , "PRESSURE" , { 0 } ) , std::logic_error );
+
+        /* The file can be read while the recorder still has it
+           open - this is the live monitoring pattern. */
+        TimeSeriesReader reader( path );
+        BOOST_CHECK_EQUAL( reader.numProbes() , 2U );
+        BOOST_CHECK_EQUAL( reader.probeName( 0 ) , "WELL_PRESSURE" );
+        BOOST_CHECK_EQUAL( reader.fieldName( 1 ) , "SAT" );
+        BOOST_CHECK_EQUAL( reader.probeSize( 0 ) , 3U );
+        BOOST_CHECK_EQUAL( reader.numSteps() , 5U );
+
+        recorder.recordStep( state , 0.5 );
+        BOOST_CHECK_EQUAL( reader.numSteps() , 6U );
+
+        BOOST_CHECK_EQUAL( reader.stepIndex( 3 ) , 3U );
+        BOOST_CHECK_CLOSE( reader.stepTime( 3 ) , 0.3 , 1e-12 );
+
+        const auto pressure = reader.values( 3 , 0 );
+        BOOST_CHECK_EQUAL( pressure.size() , 3U );
+        BOOST_CHECK_EQUAL( pressure[0] , 100.0 );
+        BOOST_CHECK_EQUAL( pressure[1] , 103.0 );
+
+        /* Float precision probes are widened to double on read. */
+        const auto sat = reader.values( 0 , 1 );
+        BOOST_CHECK_EQUAL( sat.size() , 2U );
+        BOOST_CHECK_CLOSE( sat[0] , 0.5 , 1e-5 );
+
+        BOOST_CHECK_THROW( reader.values( 100 , 0 ) , std::invalid_argument );
+    }
+    std::remove( path.c_str() );
+}
+
+
+BOOST_AUTO_TEST_CASE(TestInvalid) {
+    const std::string path = "/tmp/timeseries2.bin";
+    SimulationDataContainer state(100 , 10 , 2);
+    state.registerCellData( "PRESSURE" , 1 );
+
+    {
+        TimeSeriesRecorder recorder( path );
+        BOOST_CHECK_THROW( recorder.recordStep( state , 0 ) , std::logic_error );
+
+        recorder.addProbe( "P" , "PRESSURE" , { 1000 } );
+        BOOST_CHECK_THROW( recorder.recordStep( state , 0 ) , std::invalid_argument );
+    }
+    {
+        TimeSeriesRecorder recorder( path );
+        recorder.addProbe( "MISSING" , "NO_SUCH_FIELD" , { 0 } );
+        BOOST_CHECK_THROW( recorder.recordStep( state , 0 ) , std::invalid_argument );
+    }
+    std::remove( path.c_str() );
+
+    BOOST_CHECK_THROW( TimeSeriesReader( "/file/does/not/exist" ) , std::runtime_error );
+}
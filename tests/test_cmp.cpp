@@ -106,6 +106,82 @@ BOOST_AUTO_TEST_CASE(TestSCalarcmp) {
     }
 }
 
+/*
+  The array comparison runs a vectorizable block kernel with a scalar
+  tail; verify that both paths agree with scalar_equal, also when the
+  differing element is the very last one.
+*/
+BOOST_AUTO_TEST_CASE(TestBlockCmp) {
+    const size_t size = 100;
+    std::vector<double> v1(size);
+    std::vector<double> v2(size);
+    for (size_t i = 0; i < size; i++) {
+        v1[i] = 1e3 + i;
+        v2[i] = v1[i];
+    }
+    BOOST_CHECK( cmp::array_equal<double>( v1.data() , v2.data() , size ));
+
+    /* Differences within the epsilons must not break equality. */
+    v2[0] += 0.5 * cmp::default_abs_epsilon;
+    v2[size - 1] += 0.5 * cmp::default_abs_epsilon;
+    BOOST_CHECK( cmp::array_equal<double>( v1.data() , v2.data() , size ));
+    BOOST_CHECK( cmp::vector_equal<double>( v1 , v2 ));
+
+    /* A single differing element - in the block part and in the
+       scalar tail - must be detected. */
+    for (size_t index : { size_t(0) , size / 2 , size - 1 }) {
+        std::vector<double> v3(v1);
+        v3[index] *= (1 + 2 * cmp::default_rel_epsilon);
+        BOOST_CHECK( !cmp::array_equal<double>( v1.data() , v3.data() , size ));
+        BOOST_CHECK( !cmp::vector_equal<double>( v1 , v3 ));
+    }
+
+    /* The block kernel must agree with scalar_equal for NaN. */
+    const double nan = std::nan("");
+    std::vector<double> n1(size , nan);
+    std::vector<double> n2(size , nan);
+    BOOST_CHECK_EQUAL( cmp::scalar_equal<double>( nan , nan ) ,
+                       cmp::array_equal<double>( n1.data() , n2.data() , size ));
+}
+
+
+BOOST_AUTO_TEST_CASE(TestUlpCmp) {
+    /* The distance between adjacent representable values is 1. */
+    const double one_up = std::nextafter( 1.0 , 2.0 );
+    BOOST_CHECK_EQUAL( cmp::ulp_distance<double>( 1.0 , 1.0 ) , 0U );
+    BOOST_CHECK_EQUAL( cmp::ulp_distance<double>( 1.0 , one_up ) , 1U );
+    BOOST_CHECK_EQUAL( cmp::ulp_distance<float>( 1.0f , std::nextafter( 1.0f , 2.0f )) , 1U );
+
+    BOOST_CHECK( cmp::scalar_equal_ulp<double>( 1.0 , one_up ));
+    BOOST_CHECK( !cmp::scalar_equal_ulp<double>( 1.0 , one_up , 0 ));
+    BOOST_CHECK( !cmp::scalar_equal_ulp<double>( 1.0 , 1.0 + 1e-9 ));
+
+    /* The ordering is monotonic across zero: +0 and -0 are equal,
+       and small values of opposite sign are a few ULPs apart. */
+    BOOST_CHECK_EQUAL( cmp::ulp_distance<double>( 0.0 , -0.0 ) , 0U );
+    const double denormal = std::nextafter( 0.0 , 1.0 );
+    BOOST_CHECK_EQUAL( cmp::ulp_distance<double>( -denormal , denormal ) , 2U );
+
+    /* The comparison is on bit patterns: NaN is never ulp-equal to
+       a number, but two NaN with the same payload are. */
+    const double nan = std::nan("");
+    BOOST_CHECK( !cmp::scalar_equal_ulp<double>( nan , 1.0 ));
+    BOOST_CHECK( cmp::scalar_equal_ulp<double>( nan , nan ));
+
+    /* Array and vector variants, with the difference in the block
+       part and in the scalar tail. */
+    std::vector<double> v1(100 , 1.0);
+    std::vector<double> v2(v1);
+    BOOST_CHECK( cmp::vector_equal_ulp<double>( v1 , v2 ));
+    v2[50] = one_up;
+    v2[99] = one_up;
+    BOOST_CHECK( cmp::vector_equal_ulp<double>( v1 , v2 ));
+    BOOST_CHECK( !cmp::vector_equal_ulp<double>( v1 , v2 , 0 ));
+    v2[99] = 1.0 + 1e-9;
+    BOOST_CHECK( !cmp::array_equal_ulp<double>( v1.data() , v2.data() , v1.size() ));
+}
+
+
 /* Ensure that float instantiation works. */
 BOOST_AUTO_TEST_CASE(TestFloatcmp) {
     std::vector<float> v1;
@@ -0,0 +1,98 @@
+/*
+  Copyright 2016 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE DIFF_REPORT_TESTS
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+
+#include <opm/common/util/numeric/diff.hpp>
+
+using namespace Opm;
+
+
+BOOST_AUTO_TEST_CASE(TestEqualArrays) {
+    std::vector<double> v1(1000 , 3.14);
+    std::vector<double> v2(v1);
+
+    auto report = diff::vector_diff<double>( v1 , v2 );
+    BOOST_CHECK( report.equal() );
+    BOOST_CHECK_EQUAL( report.num_elements , 1000U );
+    BOOST_CHECK_EQUAL( report.failure_count , 0U );
+    BOOST_CHECK_EQUAL( report.first_failure , 1000U );
+    BOOST_CHECK_EQUAL( report.max_abs_deviation , 0 );
+    BOOST_CHECK_EQUAL( report.max_rel_deviation , 0 );
+
+    BOOST_CHECK_THROW( diff::vector_diff<double>( v1 , std::vector<double>(10) ) , std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE(TestDeviations) {
+    std::vector<double> v1(1000 , 100.0);
+    std::vector<double> v2(v1);
+
+    /* Within the epsilons: reported as deviation, not failure. */
+    v2[10] += 1e-9;
+    auto report = diff::vector_diff<double>( v1 , v2 );
+    BOOST_CHECK( report.equal() );
+    BOOST_CHECK_EQUAL( report.max_abs_index , 10U );
+    BOOST_CHECK_CLOSE( report.max_abs_deviation , 1e-9 , 1.0 );
+
+    /* Two failing elements; the largest deviation and the first
+       failing index are tracked independently. */
+    v2[500] = 101.0;
+    v2[700] = 103.0;
+    report = diff::vector_diff<double>( v1 , v2 );
+    BOOST_CHECK( !report.equal() );
+    BOOST_CHECK_EQUAL( report.failure_count , 2U );
+    BOOST_CHECK_EQUAL( report.first_failure , 500U );
+    BOOST_CHECK_EQUAL( report.max_abs_index , 700U );
+    BOOST_CHECK_EQUAL( report.max_abs_deviation , 3.0 );
+    BOOST_CHECK_EQUAL( report.max_rel_index , 700U );
+    BOOST_CHECK_CLOSE( report.max_rel_deviation , 3.0 / 103.0 , 1e-6 );
+}
+
+
+BOOST_AUTO_TEST_CASE(TestParallelDiff) {
+    /* Large enough to cross the serial threshold; the threaded
+       reduction must give exactly the serial report. */
+    const size_t size = 200000;
+    std::vector<double> v1(size);
+    std::vector<double> v2(size);
+    for (size_t i = 0; i < size; i++) {
+        v1[i] = 1.0 + i;
+        v2[i] = v1[i];
+    }
+    v2[100] *= (1 + 1e-3);
+    v2[150000] *= (1 + 2e-3);
+
+    auto serial = diff::vector_diff<double>( v1 , v2 , 1 );
+    auto parallel = diff::vector_diff<double>( v1 , v2 , 4 );
+
+    BOOST_CHECK_EQUAL( serial.failure_count , parallel.failure_count );
+    BOOST_CHECK_EQUAL( serial.first_failure , parallel.first_failure );
+    BOOST_CHECK_EQUAL( serial.first_failure , 100U );
+    BOOST_CHECK_EQUAL( serial.max_abs_index , parallel.max_abs_index );
+    BOOST_CHECK_EQUAL( serial.max_abs_deviation , parallel.max_abs_deviation );
+    BOOST_CHECK_EQUAL( serial.max_rel_index , parallel.max_rel_index );
+    BOOST_CHECK_EQUAL( serial.max_rel_deviation , parallel.max_rel_deviation );
+    BOOST_CHECK_EQUAL( parallel.max_abs_index , 150000U );
+}
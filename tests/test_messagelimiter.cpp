@@ -27,6 +27,10 @@
 #include <opm/common/OpmLog/MessageLimiter.hpp>
 #include <opm/common/OpmLog/LogUtil.hpp>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 using namespace Opm;
 
 
@@ -157,3 +161,54 @@ BOOST_AUTO_TEST_CASE(MixedResponse)
     }
 
 }
+
+
+BOOST_AUTO_TEST_CASE(ConcurrentResponse)
+{
+    // handleMessageLimits() is thread safe: when several threads
+    // hammer the same tag the counts must add up exactly, and the
+    // JustOverTagLimit response must be seen exactly once.
+    const int tag_limit = 10;
+    const size_t num_threads = 4;
+    const size_t messages_per_thread = 1000;
+    MessageLimiter m(tag_limit);
+
+    std::vector<std::thread> threads;
+    std::atomic<int> print_count(0);
+    std::atomic<int> just_over_count(0);
+    for (size_t t = 0; t < num_threads; t++)
+        threads.emplace_back([&m, &print_count, &just_over_count] {
+                for (size_t i = 0; i < messages_per_thread; i++) {
+                    auto res = m.handleMessageLimits("tag1", Log::MessageType::Info);
+                    if (res == MessageLimiter::Response::PrintMessage)
+                        ++print_count;
+                    else if (res == MessageLimiter::Response::JustOverTagLimit)
+                        ++just_over_count;
+                }
+            });
+    for (auto& thread : threads)
+        thread.join();
+
+    BOOST_CHECK_EQUAL(print_count.load(), tag_limit);
+    BOOST_CHECK_EQUAL(just_over_count.load(), 1);
+    BOOST_CHECK(m.categoryMessageCounts().at(Log::MessageType::Info) == tag_limit);
+}
+
+
+BOOST_AUTO_TEST_CASE(TagIdFastPath)
+{
+    // The integer tag-id overload must agree with the string
+    // overload, and counts must be shared between the two.
+    MessageLimiter m(2);
+    const int id = m.registerTag("tag1");
+    BOOST_CHECK(id != MessageLimiter::NoTag);
+    BOOST_CHECK_EQUAL(m.registerTag("tag1"), id);
+    BOOST_CHECK(m.registerTag("tag2") != id);
+    BOOST_CHECK_EQUAL(m.registerTag(""), MessageLimiter::NoTag);
+
+    BOOST_CHECK(m.handleMessageLimits(id, Log::MessageType::Info) == MessageLimiter::Response::PrintMessage);
+    BOOST_CHECK(m.handleMessageLimits("tag1", Log::MessageType::Info) == MessageLimiter::Response::PrintMessage);
+    BOOST_CHECK(m.handleMessageLimits(id, Log::MessageType::Info) == MessageLimiter::Response::JustOverTagLimit);
+    BOOST_CHECK(m.handleMessageLimits("tag1", Log::MessageType::Info) == MessageLimiter::Response::OverTagLimit);
+    BOOST_CHECK(m.categoryMessageCounts().at(Log::MessageType::Info) == 2);
+}